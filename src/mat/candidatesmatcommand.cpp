@@ -0,0 +1,138 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "candidatesmatcommand.h"
+
+#include "matcandidates.h"
+#include "matdesktopdb.h"
+#include "matglobals.h"
+#include "matmimeappslist.h"
+#include "matresolver.h"
+
+#include <QCommandLineOption>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QString>
+#include <QStringList>
+
+#include <iostream>
+
+using namespace Qt::Literals::StringLiterals;
+
+static CommandLineParseResult parseCommandLine(QCommandLineParser *parser, QStringList *mimeTypes,
+                                               MatOutput::Format *format, QString *errorMessage)
+{
+    parser->clearPositionalArguments();
+    parser->setApplicationDescription(u"List the applications able to open a mimetype, best first"_s);
+
+    parser->addPositionalArgument(u"candidates"_s, u"mimetypes"_s,
+                                  QCoreApplication::tr("mimetype [mimetype...]"));
+
+    const QCommandLineOption formatOption = MatOutput::formatOption();
+    parser->addOption(formatOption);
+    const QCommandLineOption helpOption = parser->addHelpOption();
+    const QCommandLineOption versionOption = parser->addVersionOption();
+
+    if (!parser->parse(QCoreApplication::arguments())) {
+        *errorMessage = parser->errorText();
+        return CommandLineError;
+    }
+
+    if (parser->isSet(versionOption)) {
+        return CommandLineVersionRequested;
+    }
+
+    if (parser->isSet(helpOption) || parser->isSet(u"help-all"_s)) {
+        return CommandLineHelpRequested;
+    }
+
+    if (!MatOutput::formatFromName(parser->value(formatOption), format)) {
+        *errorMessage = u"Unknown output format: "_s + parser->value(formatOption);
+        return CommandLineError;
+    }
+
+    QStringList posArgs = parser->positionalArguments();
+    posArgs.removeAt(0);
+
+    if (posArgs.isEmpty()) {
+        *errorMessage = u"MimeType missing"_s;
+        return CommandLineError;
+    }
+
+    *mimeTypes = posArgs;
+
+    return CommandLineOk;
+}
+
+CandidatesMatCommand::CandidatesMatCommand(QCommandLineParser *parser)
+    : MatCommandInterface(u"candidates"_s,
+                          u"List the applications able to open a mimetype, best first"_s,
+                          parser)
+{
+   Q_CHECK_PTR(parser);
+}
+
+CandidatesMatCommand::~CandidatesMatCommand() = default;
+
+int CandidatesMatCommand::run(const QStringList & /*arguments*/)
+{
+    QStringList mimeTypes;
+    MatOutput::Format format = MatOutput::TextFormat;
+    QString errorMessage;
+
+    switch(parseCommandLine(parser(), &mimeTypes, &format, &errorMessage)) {
+    case CommandLineOk:
+        break;
+    case CommandLineError:
+        std::cerr << qPrintable(errorMessage);
+        std::cerr << "\n\n";
+        std::cerr << qPrintable(parser()->helpText());
+        return EXIT_FAILURE;
+    case CommandLineVersionRequested:
+        showVersion();
+        Q_UNREACHABLE();
+    case CommandLineHelpRequested:
+        showHelp();
+        Q_UNREACHABLE();
+    }
+
+    output()->setFormat(format);
+
+    MatMimeAppsLayers layers;
+    MatDesktopDb db;
+    const MatResolver resolver({&layers}, {&db});
+    MatCandidates ranker(&resolver);
+
+    for (const QString &mimeType : std::as_const(mimeTypes)) {
+        const QList<MatCandidates::Candidate> candidates = ranker.candidates(mimeType);
+        for (qsizetype i = 0; i < candidates.size(); ++i) {
+            const MatCandidates::Candidate &c = candidates.at(i);
+            QString text = c.entry->id;
+            if (mimeTypes.size() > 1)
+                text.prepend(mimeType + u'\t');
+            output()->write({{"mimetype"_L1, mimeType}, {"rank"_L1, QString::number(i + 1)},
+                             {"id"_L1, c.entry->id}, {"source"_L1, MatCandidates::sourceName(c.source)},
+                             {"via"_L1, c.mimeType}, {"file"_L1, c.entry->fileName}},
+                            text);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -1,6 +1,6 @@
 /*
  * libqtxdg - An Qt implementation of freedesktop.org xdg specs
- * Copyright (C) 2021  Luís Pereira <luis.artur.pereira@gmail.com>
+ * Copyright (C) 2026  LXQt team
  *
  * This library is free software; you can redistribute it and/or
  * modify it under the terms of the GNU Lesser General Public
@@ -18,17 +18,17 @@
  * Boston, MA  02110-1301  USA
  */
 
-#ifndef DEFTERMINALMATCOMMAND_H
-#define DEFTERMINALMATCOMMAND_H
+#ifndef CANDIDATESMATCOMMAND_H
+#define CANDIDATESMATCOMMAND_H
 
 #include "matcommandinterface.h"
 
-class DefTerminalMatCommand : public MatCommandInterface {
+class CandidatesMatCommand : public MatCommandInterface {
 public:
-    explicit DefTerminalMatCommand(QCommandLineParser *parser);
-    ~DefTerminalMatCommand() override;
+    explicit CandidatesMatCommand(QCommandLineParser *parser);
+    ~CandidatesMatCommand() override;
 
     int run(const QStringList &arguments) override;
 };
 
-#endif // DEFTERMINALMATCOMMAND_H
+#endif // CANDIDATESMATCOMMAND_H
@@ -0,0 +1,308 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "checkmatcommand.h"
+
+#include "matdesktopdb.h"
+#include "matdesktopscanner.h"
+#include "matglobals.h"
+#include "matmimeappslist.h"
+
+#include <QCommandLineOption>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFile>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <iostream>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace Qt::Literals::StringLiterals;
+
+namespace {
+
+/*
+ * Shared by all the checks, most applications run a program from the same few
+ * directories, so each path is stat()ed once.
+ */
+class StatCache {
+public:
+    StatCache()
+        : mPath(qEnvironmentVariable("PATH").split(u':', Qt::SkipEmptyParts))
+    {
+    }
+
+    QString findExecutable(const QString &program)
+    {
+        if (program.contains(u'/'))
+            return isExecutable(program) ? program : QString();
+
+        for (const QString &dir : std::as_const(mPath)) {
+            const QString path = dir + u'/' + program;
+            if (isExecutable(path))
+                return path;
+        }
+        return QString();
+    }
+
+private:
+    bool isExecutable(const QString &path)
+    {
+        {
+            QMutexLocker locker(&mMutex);
+            const auto it = mExecutable.constFind(path);
+            if (it != mExecutable.constEnd())
+                return *it;
+        }
+
+        // Racing threads may both stat, that's cheaper than holding the lock
+        const QByteArray encoded = QFile::encodeName(path);
+        struct stat st;
+        const bool executable = ::stat(encoded.constData(), &st) == 0 && S_ISREG(st.st_mode)
+                && ::access(encoded.constData(), X_OK) == 0;
+
+        QMutexLocker locker(&mMutex);
+        mExecutable.insert(path, executable);
+        return executable;
+    }
+
+    const QStringList mPath;
+    QMutex mMutex;
+    QHash<QString, bool> mExecutable;
+};
+
+struct AppCheck {
+    QString problem; //!< Empty if the application is fine
+    QString detail;
+};
+
+} // namespace
+
+static AppCheck checkApp(const QString &fileName, StatCache *cache)
+{
+    if (fileName.isEmpty())
+        return {u"missing"_s, QString()};
+
+    MatDesktopScanner app;
+    if (!app.scanFile(fileName) || !app.hasDesktopEntry())
+        return {u"not-loadable"_s, fileName};
+    if (app.boolValue(MatDesktopScanner::HiddenKey))
+        return {u"hidden"_s, fileName};
+    if (app.value(MatDesktopScanner::TypeKey) != "Application")
+        return {u"not-an-application"_s, fileName};
+
+    const QString tryExec = QString::fromUtf8(app.value(MatDesktopScanner::TryExecKey));
+    if (!tryExec.isEmpty() && cache->findExecutable(tryExec).isEmpty())
+        return {u"tryexec-not-found"_s, tryExec};
+
+    const QString program = app.program();
+    if (program.isEmpty()) {
+        if (app.boolValue(MatDesktopScanner::DBusActivatableKey))
+            return {};
+        return {u"no-exec"_s, fileName};
+    }
+    if (cache->findExecutable(program).isEmpty())
+        return {u"exec-not-found"_s, program};
+
+    return {};
+}
+
+static CommandLineParseResult parseCommandLine(QCommandLineParser *parser, MatOutput::Format *format,
+                                               QString *errorMessage)
+{
+    parser->clearPositionalArguments();
+    parser->setApplicationDescription(u"Check the mimeapps.list layers for broken associations"_s);
+
+    parser->addPositionalArgument(u"check"_s, ""_L1);
+
+    const QCommandLineOption formatOption = MatOutput::formatOption();
+    parser->addOption(formatOption);
+    const QCommandLineOption helpOption = parser->addHelpOption();
+    const QCommandLineOption versionOption = parser->addVersionOption();
+
+    if (!parser->parse(QCoreApplication::arguments())) {
+        *errorMessage = parser->errorText();
+        return CommandLineError;
+    }
+
+    if (parser->isSet(versionOption)) {
+        return CommandLineVersionRequested;
+    }
+
+    if (parser->isSet(helpOption) || parser->isSet(u"help-all"_s)) {
+        return CommandLineHelpRequested;
+    }
+
+    if (!MatOutput::formatFromName(parser->value(formatOption), format)) {
+        *errorMessage = u"Unknown output format: "_s + parser->value(formatOption);
+        return CommandLineError;
+    }
+
+    QStringList posArgs = parser->positionalArguments();
+    posArgs.removeAt(0);
+
+    if (!posArgs.isEmpty()) {
+        *errorMessage = u"Extra arguments given: "_s;
+        errorMessage->append(posArgs.join(u','));
+        return CommandLineError;
+    }
+
+    return CommandLineOk;
+}
+
+CheckMatCommand::CheckMatCommand(QCommandLineParser *parser)
+    : MatCommandInterface(u"check"_s,
+                          u"Check the mimeapps.list layers for broken associations"_s,
+                          parser)
+{
+   Q_CHECK_PTR(parser);
+}
+
+CheckMatCommand::~CheckMatCommand() = default;
+
+int CheckMatCommand::run(const QStringList & /*arguments*/)
+{
+    MatOutput::Format format = MatOutput::TextFormat;
+    QString errorMessage;
+
+    switch(parseCommandLine(parser(), &format, &errorMessage)) {
+    case CommandLineOk:
+        break;
+    case CommandLineError:
+        std::cerr << qPrintable(errorMessage);
+        std::cerr << "\n\n";
+        std::cerr << qPrintable(parser()->helpText());
+        return EXIT_FAILURE;
+    case CommandLineVersionRequested:
+        showVersion();
+        Q_UNREACHABLE();
+    case CommandLineHelpRequested:
+        showHelp();
+        Q_UNREACHABLE();
+    }
+
+    output()->setFormat(format);
+
+    static const MatMimeAppsList::Group checkedGroups[] = {
+        MatMimeAppsList::DefaultApplications,
+        MatMimeAppsList::AddedAssociations
+    };
+
+    MatMimeAppsLayers layers;
+    const QList<const MatMimeAppsList *> lists = layers.layers();
+    // Listing the directories is cheap, only the referenced files get loaded
+    const QHash<QString, QString> files = MatDesktopDb::fileIndex(MatDesktopDb::applicationsDirs());
+
+    QStringList ids;
+    QHash<QString, qsizetype> idIndex;
+    for (const MatMimeAppsList *list : lists) {
+        for (MatMimeAppsList::Group group : checkedGroups) {
+            const QHash<QString, QStringList> &entries = list->entries(group);
+            for (auto it = entries.cbegin(); it != entries.cend(); ++it) {
+                for (const QString &id : it.value()) {
+                    if (!idIndex.contains(id)) {
+                        idIndex.insert(id, ids.size());
+                        ids.append(id);
+                    }
+                }
+            }
+        }
+    }
+
+    QList<AppCheck> results(ids.size());
+    AppCheck *out = results.data();
+    StatCache cache;
+    QThreadPool pool;
+    for (qsizetype i = 0; i < ids.size(); ++i) {
+        const QString fileName = files.value(ids.at(i));
+        pool.start([out, i, fileName, &cache]() {
+            out[i] = checkApp(fileName, &cache);
+        });
+    }
+    pool.waitForDone();
+
+    bool ok = true;
+    auto report = [this, &ok](const QString &file, MatMimeAppsList::Group group, const QString &mimeType,
+                              const QString &id, const QString &problem, const QString &detail) {
+        ok = false;
+        const QString groupName = MatMimeAppsList::groupName(group);
+        QString text = u"%1: [%2] %3=%4: %5"_s.arg(file, groupName, mimeType, id, problem);
+        if (!detail.isEmpty())
+            text += " ("_L1 + detail + u')';
+        output()->write({{"file"_L1, file}, {"group"_L1, groupName}, {"mimetype"_L1, mimeType},
+                         {"id"_L1, id}, {"problem"_L1, problem}, {"detail"_L1, detail}},
+                        text);
+    };
+
+    QHash<QString, bool> schemeHandled; // scheme mimetype -> a working handler is referenced
+    for (qsizetype i = 0; i < lists.size(); ++i) {
+        const MatMimeAppsList *list = lists.at(i);
+        for (MatMimeAppsList::Group group : checkedGroups) {
+            const QHash<QString, QStringList> &entries = list->entries(group);
+            QStringList mimeTypes = entries.keys();
+            std::sort(mimeTypes.begin(), mimeTypes.end());
+
+            for (const QString &mimeType : std::as_const(mimeTypes)) {
+                const bool isScheme = mimeType.startsWith("x-scheme-handler/"_L1);
+                const QStringList appIds = entries.value(mimeType);
+                for (const QString &id : appIds) {
+                    const AppCheck &result = results.at(idIndex.value(id));
+                    if (!result.problem.isEmpty())
+                        report(list->fileName(), group, mimeType, id, result.problem, result.detail);
+                    if (isScheme)
+                        schemeHandled[mimeType] |= result.problem.isEmpty();
+
+                    if (group != MatMimeAppsList::DefaultApplications)
+                        continue;
+                    // Removed Associations don't apply to defaults, such a default is likely a mistake
+                    for (qsizetype j = 0; j <= i; ++j) {
+                        if (lists.at(j)->apps(MatMimeAppsList::RemovedAssociations, mimeType).contains(id)) {
+                            report(list->fileName(), group, mimeType, id, u"removed"_s, lists.at(j)->fileName());
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    QStringList schemes = schemeHandled.keys();
+    std::sort(schemes.begin(), schemes.end());
+    for (const QString &scheme : std::as_const(schemes)) {
+        if (schemeHandled.value(scheme))
+            continue;
+        ok = false;
+        output()->write({{"file"_L1, QStringView()}, {"group"_L1, QStringView()}, {"mimetype"_L1, scheme},
+                         {"id"_L1, QStringView()}, {"problem"_L1, u"dangling-scheme-handler"},
+                         {"detail"_L1, u"no working handler is referenced"}},
+                        scheme + ": dangling-scheme-handler (no working handler is referenced)"_L1);
+    }
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -1,6 +1,6 @@
 /*
  * libqtxdg - An Qt implementation of freedesktop.org xdg specs
- * Copyright (C) 2018  Luís Pereira <luis.artur.pereira@gmail.com>
+ * Copyright (C) 2026  LXQt team
  *
  * This library is free software; you can redistribute it and/or
  * modify it under the terms of the GNU Lesser General Public
@@ -18,17 +18,17 @@
  * Boston, MA  02110-1301  USA
  */
 
-#ifndef DEFWEBBROWSERMATCOMMAND_H
-#define DEFWEBBROWSERMATCOMMAND_H
+#ifndef CHECKMATCOMMAND_H
+#define CHECKMATCOMMAND_H
 
 #include "matcommandinterface.h"
 
-class DefWebBrowserMatCommand : public MatCommandInterface {
+class CheckMatCommand : public MatCommandInterface {
 public:
-    explicit DefWebBrowserMatCommand(QCommandLineParser *parser);
-    ~DefWebBrowserMatCommand() override;
+    explicit CheckMatCommand(QCommandLineParser *parser);
+    ~CheckMatCommand() override;
 
     int run(const QStringList &arguments) override;
 };
 
-#endif // DEFWEBBROWSERMATCOMMAND_H
+#endif // CHECKMATCOMMAND_H
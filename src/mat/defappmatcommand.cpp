@@ -19,15 +19,22 @@
  */
 
 #include "defappmatcommand.h"
+#include "matdefaultwatch.h"
+#include "matdesktopdb.h"
 #include "matglobals.h"
+#include "matlinereader.h"
+#include "matmimeappslist.h"
+#include "matmimeappswriter.h"
+#include "matresolver.h"
+#include "matserver.h"
 
 #include "xdgdesktopfile.h"
-#include "xdgmimeapps.h"
 
 #include <QCommandLineOption>
 #include <QCommandLineParser>
 #include <QCoreApplication>
 #include <QDebug>
+#include <QHash>
 
 #include <iostream>
 
@@ -39,9 +46,14 @@ enum DefAppCommandMode {
 };
 
 struct DefAppData {
-    DefAppData() : mode(CommandModeGetDefApp) {}
+    DefAppData() : mode(CommandModeGetDefApp), format(MatOutput::TextFormat), watch(false), readStdin(false),
+                   nulSeparated(false) {}
 
     DefAppCommandMode mode;
+    MatOutput::Format format;
+    bool watch;
+    bool readStdin;
+    bool nulSeparated;
     QString defAppName;
     QStringList mimeTypes;
 };
@@ -57,7 +69,28 @@ static CommandLineParseResult parseCommandLine(QCommandLineParser *parser, DefAp
     const QCommandLineOption defAppNameOption(QStringList() << u"s"_s << u"set"_s,
                 u"Application to be set as default"_s, u"app name"_s);
 
+    const QCommandLineOption watchOption(QStringList() << u"w"_s << u"watch"_s,
+                u"Keep running and print the default application again whenever it changes"_s);
+
+    const QCommandLineOption stdinOption(QStringList() << u"stdin"_s,
+                u"Also read the mimetypes to get from the standard input, one per line"_s);
+
+    const QCommandLineOption nulOption(QStringList() << u"z"_s << u"null"_s,
+                u"With --stdin, the mimetypes are NUL terminated"_s);
+
+    // Resolving over the raw entries used to be opt-in, it's how every get
+    // resolves now. Still accepted for the scripts passing it.
+    QCommandLineOption noLocalizeOption(QStringList() << u"no-localize"_s, u"Does nothing"_s);
+    noLocalizeOption.setFlags(QCommandLineOption::HiddenFromHelp);
+
+    const QCommandLineOption formatOption = MatOutput::formatOption();
+
     parser->addOption(defAppNameOption);
+    parser->addOption(watchOption);
+    parser->addOption(stdinOption);
+    parser->addOption(nulOption);
+    parser->addOption(noLocalizeOption);
+    parser->addOption(formatOption);
     const QCommandLineOption helpOption = parser->addHelpOption();
     const QCommandLineOption versionOption = parser->addVersionOption();
 
@@ -74,6 +107,11 @@ static CommandLineParseResult parseCommandLine(QCommandLineParser *parser, DefAp
         return CommandLineHelpRequested;
     }
 
+    if (!MatOutput::formatFromName(parser->value(formatOption), &data->format)) {
+        *errorMessage = u"Unknown output format: "_s + parser->value(formatOption);
+        return CommandLineError;
+    }
+
     const bool isDefAppNameSet = parser->isSet(defAppNameOption);
     QString defAppName;
 
@@ -86,15 +124,20 @@ static CommandLineParseResult parseCommandLine(QCommandLineParser *parser, DefAp
     }
 
     QStringList mimeTypes = parser->positionalArguments();
+    mimeTypes.removeAt(0);
 
-    if (mimeTypes.size() < 2) {
+    const bool readStdin = parser->isSet(stdinOption);
+    if (mimeTypes.isEmpty() && !(readStdin && !isDefAppNameSet)) {
         *errorMessage = u"MimeType missing"_s;
         return CommandLineError;
     }
 
-    mimeTypes.removeAt(0);
+    if (isDefAppNameSet && (parser->isSet(watchOption) || readStdin)) {
+        *errorMessage = u"--watch and --stdin only apply to getting the default application"_s;
+        return CommandLineError;
+    }
 
-    if (!isDefAppNameSet && mimeTypes.size() > 1) {
+    if (parser->isSet(watchOption) && (mimeTypes.size() > 1 || readStdin)) {
         *errorMessage = u"Only one mimeType, please"_s;
         return CommandLineError;
     }
@@ -102,6 +145,9 @@ static CommandLineParseResult parseCommandLine(QCommandLineParser *parser, DefAp
     data->mode = isDefAppNameSet ? CommandModeSetDefApp : CommandModeGetDefApp;
     data->defAppName = defAppName;
     data->mimeTypes = mimeTypes;
+    data->watch = parser->isSet(watchOption);
+    data->readStdin = readStdin;
+    data->nulSeparated = parser->isSet(nulOption);
 
     return CommandLineOk;
 }
@@ -141,16 +187,91 @@ int DefAppMatCommand::run(const QStringList & /*arguments*/)
         Q_UNREACHABLE();
     }
 
-    if (data.mode == CommandModeGetDefApp) { // Get default App
-        XdgMimeApps apps;
+    output()->setFormat(data.format);
+
+    if (data.mode == CommandModeGetDefApp && (data.mimeTypes.size() > 1 || data.readStdin)) {
+        // Every distinct mimetype is resolved once, the records reuse its strings
+        struct Default {
+            QString id;
+            QString fileName;
+        };
+        MatMimeAppsLayers layers;
+        MatDesktopDb db;
+        const MatResolver resolver({&layers}, {&db});
+        QHash<QString, Default> defaults;
+        auto write = [this, &resolver, &defaults](const QString &mimeType) {
+            auto it = defaults.constFind(mimeType);
+            if (it == defaults.constEnd()) {
+                Default def;
+                if (const MatDesktopEntry *app = resolver.defaultApp(mimeType)) {
+                    def.id = app->id;
+                    def.fileName = app->fileName;
+                }
+                it = defaults.insert(mimeType, def);
+            }
+            // In text, as a single get but with an empty line for no default,
+            // so the lines follow the mimetypes
+            output()->write({{"mimetype"_L1, it.key()}, {"id"_L1, it->id}, {"file"_L1, it->fileName}},
+                            it->id.isEmpty() ? QStringView(u"") : QStringView(it->id));
+        };
+
+        for (const QString &mimeType : std::as_const(data.mimeTypes))
+            write(mimeType);
+
+        if (data.readStdin) {
+            MatLineReader reader(stdin, data.nulSeparated ? '\0' : '\n');
+            QString mimeType;
+            while (reader.next(&mimeType)) {
+                const QStringView trimmed = QStringView(mimeType).trimmed();
+                if (trimmed.size() != mimeType.size())
+                    mimeType = trimmed.toString();
+                if (!mimeType.isEmpty())
+                    write(mimeType);
+            }
+            if (reader.hasError()) {
+                std::cerr << "Could not read the standard input\n";
+                return EXIT_FAILURE;
+            }
+        }
+    } else if (data.mode == CommandModeGetDefApp) { // Get default App
         const QString mimeType = data.mimeTypes.constFirst();
-        XdgDesktopFile *defApp = apps.defaultApp(mimeType);
-        if (defApp != nullptr) {
-            std::cout << qPrintable(XdgDesktopFile::id(defApp->fileName())) << "\n";
-            delete defApp;
-        } else {
-//            std::cout << qPrintable(u"No default application for '%1'\n"_s.arg(mimeType));
+
+        if (data.watch) {
+            // The values come from the same backend as a plain get, the watch
+            // only tells when to ask again
+            MatDefaultWatch watch;
+            auto resolve = [&watch, &mimeType]() {
+                const MatDesktopEntry *app = watch.resolver()->defaultApp(mimeType);
+                return app != nullptr ? app->fileName : QString();
+            };
+            auto report = [this, &mimeType](const QString &fileName) {
+                const QString id = fileName.isEmpty() ? u""_s : XdgDesktopFile::id(fileName); // not null, an empty line
+                output()->write({{"mimetype"_L1, mimeType}, {"id"_L1, id}, {"file"_L1, fileName}}, id);
+                output()->flush();
+            };
+            return watch.exec(resolve, report);
         }
+
+        // A server shares the system layers among all its clients, it
+        // resolves like MatResolver
+        const QString socketPath = qEnvironmentVariable("QTXDG_MAT_SOCKET");
+        QByteArray reply;
+        if (!socketPath.isEmpty() && MatServer::query(socketPath, "defapp " + mimeType.toUtf8(), &reply)
+                && (reply == "NONE" || reply.startsWith("OK "))) {
+            if (reply.startsWith("OK ")) {
+                const QList<QByteArray> fields = reply.mid(3).split('\t');
+                const QString id = QString::fromUtf8(fields.at(0));
+                const QString fileName = QString::fromUtf8(fields.value(1));
+                output()->write({{"mimetype"_L1, mimeType}, {"id"_L1, id}, {"file"_L1, fileName}}, id);
+            }
+            return EXIT_SUCCESS;
+        }
+
+        MatMimeAppsLayers layers;
+        MatDesktopDb db;
+        const MatResolver resolver({&layers}, {&db});
+        if (const MatDesktopEntry *app = resolver.defaultApp(mimeType))
+            output()->write({{"mimetype"_L1, mimeType}, {"id"_L1, app->id}, {"file"_L1, app->fileName}}, app->id);
     } else { // Set default App
         XdgDesktopFile app;
         if (!app.load(data.defAppName)) {
@@ -158,13 +279,20 @@ int DefAppMatCommand::run(const QStringList & /*arguments*/)
             return EXIT_FAILURE;
         }
 
-        XdgMimeApps apps;
-        for (const QString &mimeType : std::as_const(data.mimeTypes)) {
-            if (!apps.setDefaultApp(mimeType, app)) {
-                std::cerr << qPrintable(u"Could not set '%1' as default for '%2'\n"_s.arg(app.fileName(), mimeType));
-                success = false;
-            } else {
-                std::cout << qPrintable(u"Set '%1' as default for '%2'\n"_s.arg(app.fileName(), mimeType));
+        // All the mimetypes in one locked write
+        const QString id = XdgDesktopFile::id(app.fileName());
+        MatMimeAppsWriter writer;
+        for (const QString &mimeType : std::as_const(data.mimeTypes))
+            writer.setDefaultApp(mimeType, id);
+
+        QString errorMessage;
+        if (!writer.commit(&errorMessage)) {
+            std::cerr << qPrintable(u"Could not set '%1' as default: %2\n"_s.arg(app.fileName(), errorMessage));
+            success = false;
+        } else {
+            for (const QString &mimeType : std::as_const(data.mimeTypes)) {
+                output()->write({{"mimetype"_L1, mimeType}, {"id"_L1, id}, {"file"_L1, app.fileName()}},
+                                u"Set '%1' as default for '%2'"_s.arg(app.fileName(), mimeType));
             }
         }
     }
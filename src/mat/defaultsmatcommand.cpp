@@ -0,0 +1,148 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "defaultsmatcommand.h"
+
+#include "matcategoryengine.h"
+#include "matglobals.h"
+#include "xdgdesktopfile.h"
+
+#include <QCommandLineOption>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QFileInfo>
+#include <QString>
+#include <QStringList>
+
+#include <algorithm>
+#include <iostream>
+
+using namespace Qt::Literals::StringLiterals;
+
+static CommandLineParseResult parseCommandLine(QCommandLineParser *parser, QStringList *names, MatOutput::Format *format,
+                                               QString *errorMessage)
+{
+    parser->clearPositionalArguments();
+    parser->setApplicationDescription(u"Get the default application of several categories at once"_s);
+
+    parser->addPositionalArgument(u"defaults"_s, u"categories"_s,
+                                  QCoreApplication::tr("[categories...]"));
+
+    const QCommandLineOption formatOption = MatOutput::formatOption();
+    parser->addOption(formatOption);
+    const QCommandLineOption helpOption = parser->addHelpOption();
+    const QCommandLineOption versionOption = parser->addVersionOption();
+
+    if (!parser->parse(QCoreApplication::arguments())) {
+        *errorMessage = parser->errorText();
+        return CommandLineError;
+    }
+
+    if (parser->isSet(versionOption)) {
+        return CommandLineVersionRequested;
+    }
+
+    if (parser->isSet(helpOption) || parser->isSet(u"help-all"_s)) {
+        return CommandLineHelpRequested;
+    }
+
+    if (!MatOutput::formatFromName(parser->value(formatOption), format)) {
+        *errorMessage = u"Unknown output format: "_s + parser->value(formatOption);
+        return CommandLineError;
+    }
+
+    QStringList posArgs = parser->positionalArguments();
+    posArgs.removeAt(0);
+
+    for (QString &name : posArgs) {
+        if (!name.startsWith("def-"_L1))
+            name.prepend("def-"_L1);
+    }
+    *names = posArgs;
+
+    return CommandLineOk;
+}
+
+DefaultsMatCommand::DefaultsMatCommand(MatCategoryEngine *engine, QCommandLineParser *parser)
+    : MatCommandInterface(u"defaults"_s,
+                          u"Get the default application of several categories at once"_s,
+                          parser),
+      mEngine(engine)
+{
+   Q_CHECK_PTR(parser);
+   Q_CHECK_PTR(engine);
+}
+
+DefaultsMatCommand::~DefaultsMatCommand() = default;
+
+int DefaultsMatCommand::run(const QStringList & /*arguments*/)
+{
+    QStringList names;
+    MatOutput::Format format = MatOutput::TextFormat;
+    QString errorMessage;
+
+    switch(parseCommandLine(parser(), &names, &format, &errorMessage)) {
+    case CommandLineOk:
+        break;
+    case CommandLineError:
+        std::cerr << qPrintable(errorMessage);
+        std::cerr << "\n\n";
+        std::cerr << qPrintable(parser()->helpText());
+        return EXIT_FAILURE;
+    case CommandLineVersionRequested:
+        showVersion();
+        Q_UNREACHABLE();
+    case CommandLineHelpRequested:
+        showHelp();
+        Q_UNREACHABLE();
+    }
+
+    output()->setFormat(format);
+
+    const QList<MatCategory> categories = mEngine->categories();
+    for (const QString &name : std::as_const(names)) {
+        const bool known = std::any_of(categories.cbegin(), categories.cend(),
+                [&name](const MatCategory &c) { return c.name == name; });
+        if (!known) {
+            std::cerr << qPrintable(u"Unknown category '%1'\n"_s.arg(name));
+            return EXIT_FAILURE;
+        }
+    }
+
+    for (const MatCategory &category : categories) {
+        if (!names.isEmpty() && !names.contains(category.name))
+            continue;
+
+        QString id;
+        QString fileName;
+        XdgDesktopFile *defApp = mEngine->defaultApp(category);
+        if (defApp != nullptr) {
+            fileName = defApp->fileName();
+            id = XdgDesktopFile::id(fileName);
+            delete defApp;
+        }
+        const QString value = category.fileNameOutput ? QFileInfo(fileName).fileName() : id;
+        output()->write({{"category"_L1, category.name}, {"id"_L1, id}, {"file"_L1, fileName}},
+                        category.name + u'\t' + value);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,268 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "defcategorymatcommand.h"
+
+#include "matdefaultwatch.h"
+#include "matglobals.h"
+#include "xdgdesktopfile.h"
+
+#include <QCommandLineOption>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QFileInfo>
+#include <QSettings>
+#include <QString>
+#include <QStringList>
+
+#include <iostream>
+
+using namespace Qt::Literals::StringLiterals;
+
+enum DefCategoryCommandMode {
+    CommandModeGetDefApp,
+    CommandModeSetDefApp,
+    CommandModeListAvailableApps
+};
+
+struct DefCategoryData {
+    DefCategoryData() : mode(CommandModeGetDefApp), format(MatOutput::TextFormat), watch(false) {}
+
+    DefCategoryCommandMode mode;
+    MatOutput::Format format;
+    bool watch;
+    QString defAppName;
+};
+
+static QString capitalized(const QString &s)
+{
+    if (s.isEmpty())
+        return s;
+    return s.at(0).toUpper() + s.mid(1);
+}
+
+static CommandLineParseResult parseCommandLine(QCommandLineParser *parser, const MatCategory &category,
+                                               DefCategoryData *data, QString *errorMessage)
+{
+    parser->clearPositionalArguments();
+    parser->setApplicationDescription(u"Get/Set the default %1"_s.arg(category.noun));
+
+    parser->addPositionalArgument(category.name, ""_L1);
+
+    const QCommandLineOption defAppNameOption(QStringList() << u"s"_s << u"set"_s,
+                u"%1 to be set as default"_s.arg(capitalized(category.noun)), category.noun);
+
+    const QCommandLineOption listAvailableOption(QStringList() << u"l"_s << u"list-available"_s,
+                u"List available %1s"_s.arg(category.noun));
+
+    const QCommandLineOption watchOption(QStringList() << u"w"_s << u"watch"_s,
+                u"Keep running and print the default %1 again whenever it changes"_s.arg(category.noun));
+
+    // Every get resolves over the raw entries now, see DefAppMatCommand
+    QCommandLineOption noLocalizeOption(QStringList() << u"no-localize"_s, u"Does nothing"_s);
+    noLocalizeOption.setFlags(QCommandLineOption::HiddenFromHelp);
+
+    const QCommandLineOption formatOption = MatOutput::formatOption();
+
+    parser->addOption(defAppNameOption);
+    parser->addOption(listAvailableOption);
+    parser->addOption(watchOption);
+    parser->addOption(noLocalizeOption);
+    parser->addOption(formatOption);
+    const QCommandLineOption helpOption = parser->addHelpOption();
+    const QCommandLineOption versionOption = parser->addVersionOption();
+
+    if (!parser->parse(QCoreApplication::arguments())) {
+        *errorMessage = parser->errorText();
+        return CommandLineError;
+    }
+
+    if (parser->isSet(versionOption)) {
+        return CommandLineVersionRequested;
+    }
+
+    if (parser->isSet(helpOption) || parser->isSet(u"help-all"_s)) {
+        return CommandLineHelpRequested;
+    }
+
+    if (!MatOutput::formatFromName(parser->value(formatOption), &data->format)) {
+        *errorMessage = u"Unknown output format: "_s + parser->value(formatOption);
+        return CommandLineError;
+    }
+
+    const bool isListAvailableSet = parser->isSet(listAvailableOption);
+    const bool isDefAppNameSet = parser->isSet(defAppNameOption);
+    QString defAppName;
+
+    if (isDefAppNameSet)
+        defAppName = parser->value(defAppNameOption);
+
+    QStringList posArgs = parser->positionalArguments();
+    posArgs.removeAt(0);
+
+    if (isDefAppNameSet && !posArgs.empty()) {
+        *errorMessage = u"Extra arguments given: "_s;
+        errorMessage->append(posArgs.join(u','));
+        return CommandLineError;
+    }
+
+    if (!isDefAppNameSet && !posArgs.empty()) {
+        *errorMessage = u"To set the default %1 use the -s/--set option"_s.arg(category.noun);
+        return CommandLineError;
+    }
+
+    if (isListAvailableSet && (isDefAppNameSet || !posArgs.empty())) {
+        *errorMessage = u"list-available can't be used with other options and doesn't take arguments"_s;
+        return CommandLineError;
+    }
+
+    if (parser->isSet(watchOption) && (isDefAppNameSet || isListAvailableSet)) {
+        *errorMessage = u"--watch only applies to getting the default %1"_s.arg(category.noun);
+        return CommandLineError;
+    }
+
+    data->watch = parser->isSet(watchOption);
+
+    if (isListAvailableSet) {
+        data->mode = CommandModeListAvailableApps;
+    } else {
+        data->mode = isDefAppNameSet ? CommandModeSetDefApp : CommandModeGetDefApp;
+        data->defAppName = defAppName;
+    }
+
+    return CommandLineOk;
+}
+
+// def-terminal has always printed file names, structured output uses ids
+void DefCategoryMatCommand::writeApp(MatOutput *output, const MatCategory &category, const QString &fileName)
+{
+    const QString id = XdgDesktopFile::id(fileName);
+    if (category.fileNameOutput && !output->isStructured())
+        output->write({{"id"_L1, id}, {"file"_L1, fileName}}, QFileInfo(fileName).fileName());
+    else
+        output->write({{"id"_L1, id}, {"file"_L1, fileName}}, id);
+}
+
+DefCategoryMatCommand::DefCategoryMatCommand(const MatCategory &category, MatCategoryEngine *engine, QCommandLineParser *parser)
+    : MatCommandInterface(category.name,
+                          u"Get/Set the default %1"_s.arg(category.noun),
+                          parser),
+      mCategory(category),
+      mEngine(engine)
+{
+   Q_CHECK_PTR(parser);
+   Q_CHECK_PTR(engine);
+}
+
+DefCategoryMatCommand::~DefCategoryMatCommand() = default;
+
+int DefCategoryMatCommand::watch()
+{
+    // The values come from the same backend as a plain get, the watch only
+    // tells when to ask again
+    MatDefaultWatch watch;
+    MatDefaultWatch::Resolve resolve;
+    if (mCategory.mimeTypes.isEmpty()) {
+        // Not a mimetype association, e.g. the terminal, kept in qtxdg.conf
+        watch.watchFile(QSettings(QSettings::UserScope, u"qtxdg"_s).fileName());
+        resolve = [this]() {
+            QString fileName;
+            if (XdgDesktopFile *app = mEngine->defaultApp(mCategory)) {
+                fileName = app->fileName();
+                delete app;
+            }
+            return fileName;
+        };
+    } else {
+        resolve = [this, &watch]() {
+            return MatCategoryEngine::defaultAppFile(mCategory, watch.resolver());
+        };
+    }
+
+    auto report = [this](const QString &fileName) {
+        if (fileName.isEmpty())
+            output()->write({{"id"_L1, QStringView()}, {"file"_L1, QStringView()}}, u""); // an empty line
+        else
+            writeApp(output(), mCategory, fileName);
+        output()->flush();
+    };
+    return watch.exec(resolve, report);
+}
+
+int DefCategoryMatCommand::run(const QStringList & /*arguments*/)
+{
+    bool success = true;
+    DefCategoryData data;
+    QString errorMessage;
+    if (!MatCommandInterface::parser()) {
+        qFatal("DefCategoryMatCommand::run: MatCommandInterface::parser() returned a null pointer");
+    }
+    switch(parseCommandLine(parser(), mCategory, &data, &errorMessage)) {
+    case CommandLineOk:
+        break;
+    case CommandLineError:
+        std::cerr << qPrintable(errorMessage);
+        std::cerr << "\n\n";
+        std::cerr << qPrintable(parser()->helpText());
+        return EXIT_FAILURE;
+    case CommandLineVersionRequested:
+        showVersion();
+        Q_UNREACHABLE();
+    case CommandLineHelpRequested:
+        showHelp();
+        Q_UNREACHABLE();
+    }
+
+    output()->setFormat(data.format);
+
+    if (data.mode == CommandModeListAvailableApps) {
+        const auto apps = mEngine->availableApps(mCategory);
+        for (const auto *app : apps)
+            writeApp(output(), mCategory, app->fileName);
+
+        return EXIT_SUCCESS;
+    }
+
+    if (data.mode == CommandModeGetDefApp && data.watch)
+        return watch();
+
+    if (data.mode == CommandModeGetDefApp) { // Get default app
+        const QString fileName = mEngine->defaultAppFile(mCategory);
+        if (!fileName.isEmpty())
+            writeApp(output(), mCategory, fileName);
+    } else { // Set default app
+        XdgDesktopFile toSetDefApp;
+        if (toSetDefApp.load(data.defAppName)) {
+            if (mEngine->setDefaultApp(mCategory, toSetDefApp)) {
+                output()->write({{"id"_L1, XdgDesktopFile::id(toSetDefApp.fileName())}, {"file"_L1, toSetDefApp.fileName()}},
+                                u"Set '%1' as the default %2"_s.arg(toSetDefApp.fileName(), mCategory.noun));
+            } else {
+                std::cerr << qPrintable(u"Could not set '%1' as the default %2\n"_s.arg(toSetDefApp.fileName(), mCategory.noun));
+                success = false;
+            }
+        } else { // could not load application file
+            std::cerr << qPrintable(u"Could not find find '%1'\n"_s.arg(data.defAppName));
+            success = false;
+        }
+    }
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,55 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#ifndef DEFCATEGORYMATCOMMAND_H
+#define DEFCATEGORYMATCOMMAND_H
+
+#include "matcategoryengine.h"
+#include "matcommandinterface.h"
+
+/*!
+ * \brief The DefCategoryMatCommand class implements the def-* commands.
+ *
+ * One instance exists per MatCategory, all sharing the same engine.
+ */
+class DefCategoryMatCommand : public MatCommandInterface {
+public:
+    explicit DefCategoryMatCommand(const MatCategory &category, MatCategoryEngine *engine, QCommandLineParser *parser);
+    ~DefCategoryMatCommand() override;
+
+    int run(const QStringList &arguments) override;
+
+    /*!
+     * \brief writeApp Writes a default application of \a category the way
+     * its get does
+     * \param output
+     * \param category
+     * \param fileName The desktop file of the application
+     */
+    static void writeApp(MatOutput *output, const MatCategory &category, const QString &fileName);
+
+private:
+    int watch();
+
+    MatCategory mCategory;
+    MatCategoryEngine *mEngine;
+};
+
+#endif // DEFCATEGORYMATCOMMAND_H
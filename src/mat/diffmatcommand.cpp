@@ -0,0 +1,145 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "diffmatcommand.h"
+
+#include "matglobals.h"
+#include "matsnapshot.h"
+
+#include <QCommandLineOption>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QString>
+#include <QStringList>
+
+#include <iostream>
+
+using namespace Qt::Literals::StringLiterals;
+
+static CommandLineParseResult parseCommandLine(QCommandLineParser *parser, QStringList *fileNames,
+                                               MatOutput::Format *format, QString *errorMessage)
+{
+    parser->clearPositionalArguments();
+    parser->setApplicationDescription(u"Compare two snapshots, or a snapshot and the current defaults.\n"
+                                      "Exits with 1 if they differ."_s);
+
+    parser->addPositionalArgument(u"diff"_s, u"snapshots"_s,
+                                  QCoreApplication::tr("from-snapshot [to-snapshot, the current defaults by default]"));
+
+    const QCommandLineOption formatOption = MatOutput::formatOption();
+    parser->addOption(formatOption);
+    const QCommandLineOption helpOption = parser->addHelpOption();
+    const QCommandLineOption versionOption = parser->addVersionOption();
+
+    if (!parser->parse(QCoreApplication::arguments())) {
+        *errorMessage = parser->errorText();
+        return CommandLineError;
+    }
+
+    if (parser->isSet(versionOption)) {
+        return CommandLineVersionRequested;
+    }
+
+    if (parser->isSet(helpOption) || parser->isSet(u"help-all"_s)) {
+        return CommandLineHelpRequested;
+    }
+
+    if (!MatOutput::formatFromName(parser->value(formatOption), format)) {
+        *errorMessage = u"Unknown output format: "_s + parser->value(formatOption);
+        return CommandLineError;
+    }
+
+    QStringList posArgs = parser->positionalArguments();
+    posArgs.removeAt(0);
+
+    if (posArgs.isEmpty()) {
+        *errorMessage = u"Snapshot missing"_s;
+        return CommandLineError;
+    }
+
+    if (posArgs.size() > 2) {
+        *errorMessage = u"At most two snapshots, please"_s;
+        return CommandLineError;
+    }
+
+    *fileNames = posArgs;
+
+    return CommandLineOk;
+}
+
+DiffMatCommand::DiffMatCommand(QCommandLineParser *parser)
+    : MatCommandInterface(u"diff"_s,
+                          u"Compare two snapshots, or a snapshot and the current defaults"_s,
+                          parser)
+{
+   Q_CHECK_PTR(parser);
+}
+
+DiffMatCommand::~DiffMatCommand() = default;
+
+int DiffMatCommand::run(const QStringList & /*arguments*/)
+{
+    QStringList fileNames;
+    MatOutput::Format format = MatOutput::TextFormat;
+    QString errorMessage;
+
+    switch(parseCommandLine(parser(), &fileNames, &format, &errorMessage)) {
+    case CommandLineOk:
+        break;
+    case CommandLineError:
+        std::cerr << qPrintable(errorMessage);
+        std::cerr << "\n\n";
+        std::cerr << qPrintable(parser()->helpText());
+        return EXIT_FAILURE;
+    case CommandLineVersionRequested:
+        showVersion();
+        Q_UNREACHABLE();
+    case CommandLineHelpRequested:
+        showHelp();
+        Q_UNREACHABLE();
+    }
+
+    output()->setFormat(format);
+
+    MatSnapshot::Table from;
+    MatSnapshot::Table to;
+    if (!MatSnapshot::load(fileNames.at(0), &from, &errorMessage)
+            || (fileNames.size() > 1 && !MatSnapshot::load(fileNames.at(1), &to, &errorMessage))) {
+        std::cerr << qPrintable(errorMessage) << '\n';
+        return EXIT_FAILURE;
+    }
+    if (fileNames.size() == 1)
+        to = MatSnapshot::live();
+
+    const QList<MatSnapshot::Change> changes = MatSnapshot::diff(from, to);
+    for (const MatSnapshot::Change &change : changes) {
+        QString text;
+        if (change.oldId.isEmpty())
+            text = u"+ %1 %2"_s.arg(change.mimeType, change.newId);
+        else if (change.newId.isEmpty())
+            text = u"- %1 %2"_s.arg(change.mimeType, change.oldId);
+        else
+            text = u"~ %1 %2 -> %3"_s.arg(change.mimeType, change.oldId, change.newId);
+        output()->write({{"mimetype"_L1, change.mimeType}, {"from"_L1, change.oldId}, {"to"_L1, change.newId}},
+                        text);
+    }
+
+    return changes.isEmpty() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
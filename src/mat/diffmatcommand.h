@@ -1,6 +1,6 @@
 /*
  * libqtxdg - An Qt implementation of freedesktop.org xdg specs
- * Copyright (C) 2020  Luís Pereira <luis.artur.pereira@gmail.com>
+ * Copyright (C) 2026  LXQt team
  *
  * This library is free software; you can redistribute it and/or
  * modify it under the terms of the GNU Lesser General Public
@@ -18,17 +18,17 @@
  * Boston, MA  02110-1301  USA
  */
 
-#ifndef DEFEMAILCLIENTMATCOMMAND_H
-#define DEFEMAILCLIENTMATCOMMAND_H
+#ifndef DIFFMATCOMMAND_H
+#define DIFFMATCOMMAND_H
 
 #include "matcommandinterface.h"
 
-class DefEmailClientMatCommand : public MatCommandInterface {
+class DiffMatCommand : public MatCommandInterface {
 public:
-    explicit DefEmailClientMatCommand(QCommandLineParser *parser);
-    ~DefEmailClientMatCommand() override;
+    explicit DiffMatCommand(QCommandLineParser *parser);
+    ~DiffMatCommand() override;
 
     int run(const QStringList &arguments) override;
 };
 
-#endif // DEFEMAILCLIENTMATCOMMAND_H
+#endif // DIFFMATCOMMAND_H
@@ -0,0 +1,163 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "handlesmatcommand.h"
+
+#include "matassociationindex.h"
+#include "matdesktopdb.h"
+#include "matglobals.h"
+#include "matmimeappslist.h"
+#include "matresolver.h"
+
+#include <QCommandLineOption>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+#include <algorithm>
+#include <iostream>
+
+using namespace Qt::Literals::StringLiterals;
+
+static CommandLineParseResult parseCommandLine(QCommandLineParser *parser, QStringList *ids, MatOutput::Format *format,
+                                               QString *errorMessage)
+{
+    parser->clearPositionalArguments();
+    parser->setApplicationDescription(u"List the mimetypes an application is associated with"_s);
+
+    parser->addPositionalArgument(u"handles"_s, u"desktop ids"_s,
+                                  QCoreApplication::tr("desktop-id [desktop-id...]"));
+
+    const QCommandLineOption formatOption = MatOutput::formatOption();
+    parser->addOption(formatOption);
+    const QCommandLineOption helpOption = parser->addHelpOption();
+    const QCommandLineOption versionOption = parser->addVersionOption();
+
+    if (!parser->parse(QCoreApplication::arguments())) {
+        *errorMessage = parser->errorText();
+        return CommandLineError;
+    }
+
+    if (parser->isSet(versionOption)) {
+        return CommandLineVersionRequested;
+    }
+
+    if (parser->isSet(helpOption) || parser->isSet(u"help-all"_s)) {
+        return CommandLineHelpRequested;
+    }
+
+    if (!MatOutput::formatFromName(parser->value(formatOption), format)) {
+        *errorMessage = u"Unknown output format: "_s + parser->value(formatOption);
+        return CommandLineError;
+    }
+
+    QStringList posArgs = parser->positionalArguments();
+    posArgs.removeAt(0);
+
+    if (posArgs.isEmpty()) {
+        *errorMessage = u"Desktop id missing"_s;
+        return CommandLineError;
+    }
+
+    for (QString &id : posArgs) {
+        if (!id.endsWith(".desktop"_L1))
+            id.append(".desktop"_L1);
+    }
+    *ids = posArgs;
+
+    return CommandLineOk;
+}
+
+HandlesMatCommand::HandlesMatCommand(QCommandLineParser *parser)
+    : MatCommandInterface(u"handles"_s,
+                          u"List the mimetypes an application is associated with"_s,
+                          parser)
+{
+   Q_CHECK_PTR(parser);
+}
+
+HandlesMatCommand::~HandlesMatCommand() = default;
+
+int HandlesMatCommand::run(const QStringList & /*arguments*/)
+{
+    QStringList ids;
+    MatOutput::Format format = MatOutput::TextFormat;
+    QString errorMessage;
+
+    switch(parseCommandLine(parser(), &ids, &format, &errorMessage)) {
+    case CommandLineOk:
+        break;
+    case CommandLineError:
+        std::cerr << qPrintable(errorMessage);
+        std::cerr << "\n\n";
+        std::cerr << qPrintable(parser()->helpText());
+        return EXIT_FAILURE;
+    case CommandLineVersionRequested:
+        showVersion();
+        Q_UNREACHABLE();
+    case CommandLineHelpRequested:
+        showHelp();
+        Q_UNREACHABLE();
+    }
+
+    output()->setFormat(format);
+
+    MatMimeAppsLayers layers;
+    MatDesktopDb db;
+    const MatAssociationIndex index(&layers, &db);
+    const MatResolver resolver({&layers}, {&db});
+
+    for (const QString &id : std::as_const(ids)) {
+        QList<MatAssociationIndex::Association> associations = index.associations(id);
+        std::stable_sort(associations.begin(), associations.end(),
+                [](const MatAssociationIndex::Association &a, const MatAssociationIndex::Association &b) {
+                    return a.mimeType < b.mimeType;
+                });
+
+        QSet<QString> seen;
+        for (const MatAssociationIndex::Association &association : std::as_const(associations)) {
+            const QString relation = MatAssociationIndex::relationName(association.relation);
+            QString text = association.mimeType + u'\t' + relation + u'\t' + association.fileName;
+            if (ids.size() > 1)
+                text.prepend(id + u'\t');
+            output()->write({{"id"_L1, id}, {"mimetype"_L1, association.mimeType},
+                             {"relation"_L1, relation}, {"file"_L1, association.fileName}},
+                            text);
+
+            // Tell whether the application actually wins, once per mimetype
+            if (seen.contains(association.mimeType))
+                continue;
+            seen.insert(association.mimeType);
+            const MatDesktopEntry *defApp = resolver.defaultApp(association.mimeType);
+            if (defApp == nullptr || defApp->id != id)
+                continue;
+            text = association.mimeType + u"\teffective\t"_s + defApp->fileName;
+            if (ids.size() > 1)
+                text.prepend(id + u'\t');
+            output()->write({{"id"_L1, id}, {"mimetype"_L1, association.mimeType},
+                             {"relation"_L1, u"effective"}, {"file"_L1, defApp->fileName}},
+                            text);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
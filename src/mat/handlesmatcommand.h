@@ -1,6 +1,6 @@
 /*
  * libqtxdg - An Qt implementation of freedesktop.org xdg specs
- * Copyright (C) 2020  Luís Pereira <luis.artur.pereira@gmail.com>
+ * Copyright (C) 2026  LXQt team
  *
  * This library is free software; you can redistribute it and/or
  * modify it under the terms of the GNU Lesser General Public
@@ -18,17 +18,17 @@
  * Boston, MA  02110-1301  USA
  */
 
-#ifndef DEFFILEMANAGERMATCOMMAND_H
-#define DEFFILEMANAGERMATCOMMAND_H
+#ifndef HANDLESMATCOMMAND_H
+#define HANDLESMATCOMMAND_H
 
 #include "matcommandinterface.h"
 
-class DefFileManagerMatCommand : public MatCommandInterface {
+class HandlesMatCommand : public MatCommandInterface {
 public:
-    explicit DefFileManagerMatCommand(QCommandLineParser *parser);
-    ~DefFileManagerMatCommand() override;
+    explicit HandlesMatCommand(QCommandLineParser *parser);
+    ~HandlesMatCommand() override;
 
     int run(const QStringList &arguments) override;
 };
 
-#endif // DEFFILEMANAGERMATCOMMAND_H
+#endif // HANDLESMATCOMMAND_H
@@ -0,0 +1,138 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "matallocstats.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+
+#if defined(QTXDG_MAT_ALLOC_STATS) && defined(__GLIBC__)
+#define MAT_COUNT_ALLOCATIONS
+
+static std::atomic<quint64> allocationCount{0};
+
+// glibc's own entry points, the wrappers below replace the public ones
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void *__libc_memalign(size_t alignment, size_t size);
+void *__libc_valloc(size_t size);
+void *__libc_pvalloc(size_t size);
+
+void *malloc(size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_realloc(ptr, size);
+}
+
+// The aligned ones too, operator new with an alignment ends up here
+void *memalign(size_t alignment, size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_memalign(alignment, size);
+}
+
+void *aligned_alloc(size_t alignment, size_t size)
+{
+    // glibc only refuses an alignment that isn't a power of two
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+        errno = EINVAL;
+        return nullptr;
+    }
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void **ptr, size_t alignment, size_t size)
+{
+    if (alignment % sizeof(void *) != 0 || (alignment & (alignment - 1)) != 0 || alignment == 0)
+        return EINVAL;
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    void *p = __libc_memalign(alignment, size);
+    if (p == nullptr)
+        return ENOMEM;
+    *ptr = p;
+    return 0;
+}
+
+void *valloc(size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_valloc(size);
+}
+
+void *pvalloc(size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_pvalloc(size);
+}
+} // extern "C"
+#endif
+
+bool MatAllocStats::isAvailable()
+{
+#ifdef MAT_COUNT_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+quint64 MatAllocStats::allocations()
+{
+#ifdef MAT_COUNT_ALLOCATIONS
+    return allocationCount.load(std::memory_order_relaxed);
+#else
+    return 0;
+#endif
+}
+
+void MatAllocStats::report(quint64 items)
+{
+    if (!isAvailable())
+        return;
+
+    // Plain stdio, reporting mustn't allocate through Qt
+    const char *fileName = std::getenv("QTXDG_MAT_ALLOC_STATS");
+    if (fileName == nullptr || *fileName == '\0')
+        return;
+
+    const quint64 count = allocations();
+    if (FILE *file = std::fopen(fileName, "w")) {
+        std::fprintf(file, "allocations=%llu items=%llu\n", static_cast<unsigned long long>(count),
+                     static_cast<unsigned long long>(items));
+        std::fclose(file);
+    }
+}
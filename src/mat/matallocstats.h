@@ -0,0 +1,60 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#ifndef MATALLOCSTATS_H
+#define MATALLOCSTATS_H
+
+#include <QtGlobal>
+
+/*!
+ * \brief The MatAllocStats class counts the heap allocations of a run, for
+ * the allocation budgets of qtxdg-mat-replay.
+ *
+ * Counting needs a build with the QTXDG_MAT_ALLOC_STATS CMake option, on
+ * glibc: malloc(), calloc(), realloc() and the aligned allocators, memalign(),
+ * posix_memalign(), aligned_alloc(), valloc() and pvalloc(), are then wrapped.
+ * What a library maps by itself, or allocates inside glibc without going
+ * through those entry points, isn't counted. The count is only written out
+ * when the QTXDG_MAT_ALLOC_STATS environment variable names a file.
+ */
+class MatAllocStats {
+
+public:
+    /*!
+     * \brief isAvailable
+     * \return true if allocations are counted
+     */
+    static bool isAvailable();
+
+    /*!
+     * \brief allocations
+     * \return The allocations so far
+     */
+    static quint64 allocations();
+
+    /*!
+     * \brief report Writes "allocations=<n> items=<n>" to the file named by
+     * QTXDG_MAT_ALLOC_STATS, if counting is available and the variable set
+     * \param items The records written by the command
+     */
+    static void report(quint64 items);
+};
+
+#endif // MATALLOCSTATS_H
@@ -0,0 +1,78 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "matassociationindex.h"
+
+#include "matdesktopdb.h"
+#include "matmimeappslist.h"
+
+using namespace Qt::Literals::StringLiterals;
+
+MatAssociationIndex::MatAssociationIndex(MatMimeAppsLayers *layers, MatDesktopDb *db)
+{
+    static const struct {
+        MatMimeAppsList::Group group;
+        Relation relation;
+    } groups[] = {
+        { MatMimeAppsList::DefaultApplications, Default },
+        { MatMimeAppsList::AddedAssociations, Added },
+        { MatMimeAppsList::RemovedAssociations, Removed }
+    };
+
+    const QList<const MatMimeAppsList *> lists = layers->layers();
+    for (const MatMimeAppsList *list : lists) {
+        for (const auto &g : groups) {
+            const QHash<QString, QStringList> &entries = list->entries(g.group);
+            for (auto it = entries.cbegin(); it != entries.cend(); ++it) {
+                for (const QString &id : it.value())
+                    mIndex[id].append(Association{it.key(), g.relation, list->fileName()});
+            }
+        }
+    }
+
+    if (db == nullptr)
+        return;
+
+    const QList<const MatDesktopEntry *> entries = db->entries();
+    for (const MatDesktopEntry *entry : entries) {
+        for (const QString &mimeType : entry->mimeTypes)
+            mIndex[entry->id].append(Association{mimeType, Declared, entry->fileName});
+    }
+}
+
+QList<MatAssociationIndex::Association> MatAssociationIndex::associations(const QString &id) const
+{
+    return mIndex.value(id);
+}
+
+QString MatAssociationIndex::relationName(Relation relation)
+{
+    switch (relation) {
+    case Default:
+        return u"default"_s;
+    case Added:
+        return u"added"_s;
+    case Removed:
+        return u"removed"_s;
+    case Declared:
+        return u"declared"_s;
+    }
+    return QString();
+}
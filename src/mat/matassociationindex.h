@@ -0,0 +1,79 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#ifndef MATASSOCIATIONINDEX_H
+#define MATASSOCIATIONINDEX_H
+
+#include <QHash>
+#include <QList>
+#include <QString>
+
+class MatDesktopDb;
+class MatMimeAppsLayers;
+
+/*!
+ * \brief The MatAssociationIndex class maps desktop ids to the mimetypes
+ * they are associated with.
+ *
+ * It is the inverse of the mimeapps.list layers and of the desktop files
+ * MimeType keys, built in one pass over all of them.
+ */
+class MatAssociationIndex {
+
+public:
+    enum Relation {
+        Default,  //!< Listed in [Default Applications]
+        Added,    //!< Listed in [Added Associations]
+        Removed,  //!< Listed in [Removed Associations]
+        Declared  //!< Declared by the desktop file MimeType key
+    };
+
+    struct Association {
+        QString mimeType;
+        Relation relation;
+        QString fileName; //!< The mimeapps.list or the desktop file
+    };
+
+    /*!
+     * \brief MatAssociationIndex
+     * \param layers
+     * \param db May be nullptr, then there are no Declared associations
+     */
+    MatAssociationIndex(MatMimeAppsLayers *layers, MatDesktopDb *db);
+
+    /*!
+     * \brief associations
+     * \param id A desktop id
+     * \return The associations of \a id, most important layer first
+     */
+    QList<Association> associations(const QString &id) const;
+
+    /*!
+     * \brief relationName
+     * \param relation
+     * \return "default", "added", "removed" or "declared"
+     */
+    static QString relationName(Relation relation);
+
+private:
+    QHash<QString, QList<Association>> mIndex;
+};
+
+#endif // MATASSOCIATIONINDEX_H
@@ -0,0 +1,116 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "matcandidates.h"
+
+#include "matdesktopdb.h"
+
+#include <QMimeType>
+#include <QSet>
+
+using namespace Qt::Literals::StringLiterals;
+
+MatCandidates::MatCandidates(const MatResolver *resolver)
+    : mResolver(resolver)
+{
+    Q_CHECK_PTR(resolver);
+}
+
+QList<MatCandidates::Candidate> MatCandidates::candidates(const QString &mimeType)
+{
+    const QSet<QString> removed = mResolver->removedApps(mimeType);
+    const QStringList types = hierarchy(mimeType);
+
+    QList<Candidate> result;
+    QSet<QString> seen;
+    for (const QString &type : types) {
+        const QList<MatResolver::Candidate> &direct = directCandidates(type);
+        for (const MatResolver::Candidate &c : direct) {
+            if (removed.contains(c.entry->id) || seen.contains(c.entry->id))
+                continue;
+            seen.insert(c.entry->id);
+            result.append(Candidate{c.entry, c.source, type});
+        }
+    }
+    return result;
+}
+
+const QStringList &MatCandidates::hierarchy(const QString &mimeType)
+{
+    auto it = mHierarchies.constFind(mimeType);
+    if (it != mHierarchies.constEnd())
+        return *it;
+
+    QStringList types{mimeType};
+    // Guards against a broken shared-mime-info with cyclic parents
+    mHierarchies.insert(mimeType, types);
+
+    const QMimeType mt = mMimeDb.mimeTypeForName(mimeType);
+    if (mt.isValid()) {
+        // mimeapps.list may name the canonical type or any of its aliases
+        if (mt.name() != mimeType)
+            types.append(mt.name());
+        const QStringList aliases = mt.aliases();
+        for (const QString &alias : aliases) {
+            if (!types.contains(alias))
+                types.append(alias);
+        }
+
+        // The parents are memoized too, so siblings share their ancestors
+        const QStringList parents = mt.parentMimeTypes();
+        QStringList ancestors;
+        for (const QString &parent : parents) {
+            if (!types.contains(parent) && !ancestors.contains(parent))
+                ancestors.append(parent);
+        }
+        for (const QString &parent : parents) {
+            // A copy, the recursion may rehash mHierarchies
+            const QStringList parentHierarchy = hierarchy(parent);
+            for (const QString &type : parentHierarchy) {
+                if (!types.contains(type) && !ancestors.contains(type))
+                    ancestors.append(type);
+            }
+        }
+        types.append(ancestors);
+    }
+
+    return *mHierarchies.insert(mimeType, types);
+}
+
+QString MatCandidates::sourceName(MatResolver::Source source)
+{
+    switch (source) {
+    case MatResolver::DefaultSource:
+        return u"default"_s;
+    case MatResolver::AddedSource:
+        return u"added"_s;
+    case MatResolver::DeclaredSource:
+        return u"declared"_s;
+    }
+    return QString();
+}
+
+const QList<MatResolver::Candidate> &MatCandidates::directCandidates(const QString &mimeType)
+{
+    auto it = mDirect.constFind(mimeType);
+    if (it != mDirect.constEnd())
+        return *it;
+    return *mDirect.insert(mimeType, mResolver->candidates(mimeType));
+}
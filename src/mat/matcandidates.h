@@ -0,0 +1,89 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#ifndef MATCANDIDATES_H
+#define MATCANDIDATES_H
+
+#include "matresolver.h"
+
+#include <QHash>
+#include <QList>
+#include <QMimeDatabase>
+#include <QString>
+#include <QStringList>
+
+/*!
+ * \brief The MatCandidates class ranks every application able to open a
+ * mimetype, falling back to the aliases and the parents of the mimetype.
+ *
+ * Both the mimetype hierarchy and the candidates of each single mimetype are
+ * memoized, so querying many related mimetypes walks the shared ancestors,
+ * e.g. text/plain, only once.
+ */
+class MatCandidates {
+
+public:
+    struct Candidate {
+        const MatDesktopEntry *entry;
+        MatResolver::Source source;
+        QString mimeType; //!< The mimetype, alias or ancestor it was found for
+    };
+
+    /*!
+     * \brief MatCandidates
+     * \param resolver Not owned, must outlive this object
+     */
+    explicit MatCandidates(const MatResolver *resolver);
+
+    /*!
+     * \brief candidates
+     *
+     * The candidates of \a mimeType come first, then the ones of its aliases,
+     * then the ones of its ancestors, nearest first. Applications removed
+     * from \a mimeType are left out everywhere.
+     * \param mimeType
+     * \return The ranked candidates, without duplicates
+     */
+    QList<Candidate> candidates(const QString &mimeType);
+
+    /*!
+     * \brief hierarchy
+     * \param mimeType
+     * \return \a mimeType, its aliases and its ancestors breadth first
+     */
+    const QStringList &hierarchy(const QString &mimeType);
+
+    /*!
+     * \brief sourceName
+     * \param source
+     * \return "default", "added" or "declared"
+     */
+    static QString sourceName(MatResolver::Source source);
+
+private:
+    const QList<MatResolver::Candidate> &directCandidates(const QString &mimeType);
+
+    const MatResolver *mResolver;
+    QMimeDatabase mMimeDb;
+    QHash<QString, QStringList> mHierarchies;
+    QHash<QString, QList<MatResolver::Candidate>> mDirect;
+};
+
+#endif // MATCANDIDATES_H
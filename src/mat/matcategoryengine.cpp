@@ -0,0 +1,266 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "matcategoryengine.h"
+
+#include "matmimeappslist.h"
+#include "matmimeappswriter.h"
+#include "matresolver.h"
+#include "xdgdefaultapps.h"
+#include "xdgdesktopfile.h"
+#include "xdgdirs.h"
+#include "xdgmimeapps.h"
+
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QSettings>
+
+#include <algorithm>
+#include <iostream>
+
+using namespace Qt::Literals::StringLiterals;
+
+static const auto siteCategoriesFile = "/qtxdg-mat/categories.conf"_L1;
+
+static QStringList trimmedList(const QStringList &list)
+{
+    QStringList trimmed;
+    for (const QString &s : list) {
+        const QString t = s.trimmed();
+        if (!t.isEmpty())
+            trimmed.append(t);
+    }
+    return trimmed;
+}
+
+static bool matchesAny(const QStringList &wanted, const QStringList &provided)
+{
+    if (wanted.isEmpty())
+        return true;
+
+    for (const QString &s : wanted) {
+        if (provided.contains(s))
+            return true;
+    }
+    return false;
+}
+
+MatCategoryEngine::MatCategoryEngine() = default;
+
+MatCategoryEngine::~MatCategoryEngine() = default;
+
+QList<MatCategory> MatCategoryEngine::categories() const
+{
+    if (mCategories.isEmpty()) {
+        mCategories = builtinCategories();
+        const QList<MatCategory> site = siteCategories();
+        for (const MatCategory &category : site) {
+            const bool taken = std::any_of(mCategories.cbegin(), mCategories.cend(),
+                    [&category](const MatCategory &c) { return c.name == category.name; });
+            if (!taken)
+                mCategories.append(category);
+        }
+    }
+    return mCategories;
+}
+
+XdgDesktopFile *MatCategoryEngine::defaultApp(const MatCategory &category)
+{
+    XdgDesktopFile *app = nullptr;
+    if (category.getter) {
+        app = category.getter();
+    } else {
+        for (const QString &mimeType : category.mimeTypes) {
+            app = mimeApps()->defaultApp(mimeType);
+            if (app != nullptr)
+                break;
+        }
+    }
+
+    if (app != nullptr && !app->isValid()) {
+        delete app;
+        app = nullptr;
+    }
+    return app;
+}
+
+QString MatCategoryEngine::defaultAppFile(const MatCategory &category)
+{
+    if (category.mimeTypes.isEmpty()) {
+        QString fileName;
+        if (XdgDesktopFile *app = defaultApp(category)) {
+            fileName = app->fileName();
+            delete app;
+        }
+        return fileName;
+    }
+    return defaultAppFile(category, resolver());
+}
+
+QString MatCategoryEngine::defaultAppFile(const MatCategory &category, const MatResolver *resolver)
+{
+    // A built-in category stays with the one mimetype its getter asks for,
+    // e.g. only x-scheme-handler/http for the web browser
+    const qsizetype count = category.getter ? qMin<qsizetype>(1, category.mimeTypes.size()) : category.mimeTypes.size();
+    for (qsizetype i = 0; i < count; ++i) {
+        if (const MatDesktopEntry *app = resolver->defaultApp(category.mimeTypes.at(i)))
+            return app->fileName;
+    }
+    return QString();
+}
+
+const MatResolver *MatCategoryEngine::resolver()
+{
+    if (mResolver.isNull()) {
+        mLayers.reset(new MatMimeAppsLayers);
+        mResolver.reset(new MatResolver({mLayers.data()}, {&mDesktopDb}));
+    }
+    return mResolver.data();
+}
+
+bool MatCategoryEngine::setDefaultApp(const MatCategory &category, const XdgDesktopFile &app)
+{
+    if (category.setter)
+        return category.setter(app);
+
+    if (category.mimeTypes.isEmpty())
+        return false;
+
+    const QString id = XdgDesktopFile::id(app.fileName());
+    MatMimeAppsWriter writer;
+    for (const QString &mimeType : category.mimeTypes)
+        writer.setDefaultApp(mimeType, id);
+
+    QString errorMessage;
+    if (!writer.commit(&errorMessage)) {
+        std::cerr << qPrintable(errorMessage) << '\n';
+        return false;
+    }
+    return true;
+}
+
+QList<const MatDesktopEntry *> MatCategoryEngine::availableApps(const MatCategory &category)
+{
+    QList<const MatDesktopEntry *> apps;
+    const QList<const MatDesktopEntry *> entries = mDesktopDb.entries();
+    for (const MatDesktopEntry *entry : entries) {
+        if (matchesAny(category.categories, entry->categories) && matchesAny(category.mimeTypes, entry->mimeTypes))
+            apps.append(entry);
+    }
+    return apps;
+}
+
+XdgMimeApps *MatCategoryEngine::mimeApps()
+{
+    if (mMimeApps.isNull())
+        mMimeApps.reset(new XdgMimeApps);
+    return mMimeApps.data();
+}
+
+QList<MatCategory> MatCategoryEngine::builtinCategories()
+{
+    QList<MatCategory> list;
+
+    MatCategory webBrowser;
+    webBrowser.name = u"def-web-browser"_s;
+    webBrowser.noun = u"web browser"_s;
+    webBrowser.categories = QStringList() << u"WebBrowser"_s;
+    webBrowser.mimeTypes = QStringList() << u"x-scheme-handler/http"_s << u"x-scheme-handler/https"_s
+                                         << u"x-scheme-handler/about"_s << u"x-scheme-handler/unknown"_s;
+    webBrowser.getter = &XdgDefaultApps::webBrowser;
+    list.append(webBrowser);
+
+    MatCategory emailClient;
+    emailClient.name = u"def-email-client"_s;
+    emailClient.noun = u"email client"_s;
+    emailClient.categories = QStringList() << u"Email"_s;
+    emailClient.mimeTypes = QStringList() << u"x-scheme-handler/mailto"_s;
+    emailClient.getter = &XdgDefaultApps::emailClient;
+    list.append(emailClient);
+
+    MatCategory fileManager;
+    fileManager.name = u"def-file-manager"_s;
+    fileManager.noun = u"file manager"_s;
+    fileManager.categories = QStringList() << u"FileManager"_s;
+    fileManager.mimeTypes = QStringList() << u"inode/directory"_s;
+    fileManager.getter = &XdgDefaultApps::fileManager;
+    list.append(fileManager);
+
+    MatCategory terminal;
+    terminal.name = u"def-terminal"_s;
+    terminal.noun = u"terminal"_s;
+    terminal.categories = QStringList() << u"TerminalEmulator"_s;
+    terminal.getter = &XdgDefaultApps::terminal;
+    terminal.setter = &XdgDefaultApps::setTerminal;
+    terminal.fileNameOutput = true;
+    list.append(terminal);
+
+    return list;
+}
+
+/*
+ * Site categories live in qtxdg-mat/categories.conf under the XDG config
+ * dirs. Each group defines the def-<group> command:
+ *
+ *   [image-viewer]
+ *   Name=image viewer
+ *   MimeTypes=image/png, image/jpeg, image/gif
+ *   Categories=Graphics, Viewer
+ *
+ * A group in a more important config dir replaces the same group of the less
+ * important ones.
+ */
+QList<MatCategory> MatCategoryEngine::siteCategories()
+{
+    static const QRegularExpression validName(u"^[a-z0-9][a-z0-9-]*$"_s);
+
+    QStringList files;
+    files.append(XdgDirs::configHome(false) + siteCategoriesFile);
+    const QStringList configDirs = XdgDirs::configDirs();
+    for (const QString &dir : configDirs)
+        files.append(dir + siteCategoriesFile);
+
+    QList<MatCategory> list;
+    QStringList seen;
+    for (const QString &file : std::as_const(files)) {
+        if (!QFileInfo::exists(file))
+            continue;
+
+        QSettings settings(file, QSettings::IniFormat);
+        const QStringList groups = settings.childGroups();
+        for (const QString &group : groups) {
+            if (seen.contains(group) || !validName.match(group).hasMatch())
+                continue;
+            seen.append(group);
+
+            settings.beginGroup(group);
+            MatCategory category;
+            category.name = "def-"_L1 + group;
+            category.noun = settings.value(u"Name"_s, group).toString();
+            category.mimeTypes = trimmedList(settings.value(u"MimeTypes"_s).toStringList());
+            category.categories = trimmedList(settings.value(u"Categories"_s).toStringList());
+            settings.endGroup();
+
+            if (!category.mimeTypes.isEmpty())
+                list.append(category);
+        }
+    }
+    return list;
+}
@@ -0,0 +1,161 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#ifndef MATCATEGORYENGINE_H
+#define MATCATEGORYENGINE_H
+
+#include "matdesktopdb.h"
+
+#include <QList>
+#include <QScopedPointer>
+#include <QString>
+#include <QStringList>
+
+class MatMimeAppsLayers;
+class MatResolver;
+class XdgDesktopFile;
+class XdgMimeApps;
+
+/*!
+ * \brief The MatCategory struct describes a default application category.
+ *
+ * Built-in categories are read through the XdgDefaultApps getters. Site
+ * categories, read from qtxdg-mat/categories.conf, have none and resolve
+ * through XdgMimeApps over their mimetypes instead. Setting a category writes
+ * the default of all its mimetypes at once, except for the terminal, which
+ * isn't a mimetype association and keeps its XdgDefaultApps setter.
+ */
+struct MatCategory {
+    using Getter = XdgDesktopFile *(*)();
+    using Setter = bool (*)(const XdgDesktopFile &);
+
+    QString name;           //!< Command name, e.g. "def-web-browser"
+    QString noun;           //!< Human readable name, e.g. "web browser"
+    QStringList categories; //!< Desktop entry categories, any of them matches
+    QStringList mimeTypes;  //!< Mimetypes handled, any of them matches
+    Getter getter = nullptr;
+    Setter setter = nullptr;
+    bool fileNameOutput = false; //!< Print file names instead of desktop ids
+};
+
+/*!
+ * \brief The MatCategoryEngine class resolves default application categories
+ * over one shared MatDesktopDb.
+ */
+class MatCategoryEngine {
+
+public:
+    /*!
+     * \brief MatCategoryEngine
+     */
+    MatCategoryEngine();
+
+    /*!
+     * \brief ~MatCategoryEngine
+     */
+    virtual ~MatCategoryEngine();
+
+    /*!
+     * \brief categories
+     * \return The built-in categories followed by the site defined ones
+     */
+    QList<MatCategory> categories() const;
+
+    /*!
+     * \brief defaultApp
+     * \param category
+     * \return The default application, owned by the caller, or nullptr
+     */
+    XdgDesktopFile *defaultApp(const MatCategory &category);
+
+    /*!
+     * \brief defaultAppFile Resolves without loading or localizing any
+     * desktop file
+     *
+     * The mimetypes of the category, only the first one for a built-in
+     * category as its getter does, are resolved over the raw [Desktop Entry]
+     * keys of the shared MatDesktopDb, in the XdgMimeApps order: see
+     * MatResolver::defaultApp(). A category without mimetypes, e.g. the
+     * terminal, still asks its getter, which loads a single file.
+     * \param category
+     * \return The file name of the default application or an empty string
+     */
+    QString defaultAppFile(const MatCategory &category);
+
+    /*!
+     * \brief defaultAppFile Resolves the mimetypes of \a category like
+     * defaultAppFile() does, over another resolver
+     * \param category A category with mimetypes
+     * \param resolver
+     * \return The file name of the default application or an empty string
+     */
+    static QString defaultAppFile(const MatCategory &category, const MatResolver *resolver);
+
+    /*!
+     * \brief resolver
+     * \return A resolver over the mimeapps.list layers and the shared
+     * MatDesktopDb, created on first use
+     */
+    const MatResolver *resolver();
+
+    /*!
+     * \brief setDefaultApp
+     * \param category
+     * \param app
+     * \return true on success
+     */
+    bool setDefaultApp(const MatCategory &category, const XdgDesktopFile &app);
+
+    /*!
+     * \brief availableApps
+     * \param category
+     * \return The installed applications matching \a category
+     */
+    QList<const MatDesktopEntry *> availableApps(const MatCategory &category);
+
+    /*!
+     * \brief desktopDb
+     * \return The shared desktop database
+     */
+    inline MatDesktopDb *desktopDb() { return &mDesktopDb; }
+
+    /*!
+     * \brief builtinCategories
+     * \return The categories backed by XdgDefaultApps
+     */
+    static QList<MatCategory> builtinCategories();
+
+    /*!
+     * \brief siteCategories
+     * \return The categories defined in qtxdg-mat/categories.conf
+     */
+    static QList<MatCategory> siteCategories();
+
+private:
+    XdgMimeApps *mimeApps();
+
+    MatDesktopDb mDesktopDb;
+    QScopedPointer<XdgMimeApps> mMimeApps;
+    QScopedPointer<MatMimeAppsLayers> mLayers;
+    QScopedPointer<MatResolver> mResolver;
+    mutable QList<MatCategory> mCategories;
+};
+
+#endif // MATCATEGORYENGINE_H
@@ -21,6 +21,8 @@
 #ifndef MATCOMMANDINTERFACE_H
 #define MATCOMMANDINTERFACE_H
 
+#include "matoutput.h"
+
 #include <QStringList>
 
 class QCommandLineParser;
@@ -61,6 +63,12 @@ public:
      */
     inline QCommandLineParser *parser() const { return mParser; }
 
+    /*!
+     * \brief output
+     * \return The writer for the command results
+     */
+    inline MatOutput *output() { return &mOutput; }
+
     /*!
      * \brief run
      * \param arguments
@@ -83,6 +91,7 @@ private:
     QString mName;
     QString mDescription;
     QCommandLineParser *mParser;
+    MatOutput mOutput;
 };
 
 #endif // MATCOMMANDINTERFACE_H
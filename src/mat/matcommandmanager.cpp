@@ -30,34 +30,55 @@ MatCommandManager::MatCommandManager() = default;
 
 MatCommandManager::~MatCommandManager()
 {
-    qDeleteAll(mCommands);
-    mCommands.clear();
+    for (const Entry &entry : std::as_const(mEntries))
+        delete entry.command;
+    mEntries.clear();
 }
 
-void MatCommandManager::add(MatCommandInterface *cmd)
+void MatCommandManager::add(const QString &name, const Factory &factory)
 {
-    mCommands.append(cmd);
+    mEntries.append({name, factory, nullptr});
 }
 
-QList<MatCommandInterface *> MatCommandManager::commands() const
+bool MatCommandManager::contains(const QString &name) const
 {
-    return mCommands;
+    for (const Entry &entry : mEntries) {
+        if (entry.name == name)
+            return true;
+    }
+    return false;
+}
+
+MatCommandInterface *MatCommandManager::command(const QString &name)
+{
+    for (Entry &entry : mEntries) {
+        if (entry.name == name)
+            return create(&entry);
+    }
+    return nullptr;
+}
+
+MatCommandInterface *MatCommandManager::create(Entry *entry)
+{
+    if (entry->command == nullptr)
+        entry->command = entry->factory();
+    return entry->command;
 }
 
-QString MatCommandManager::descriptionsHelpText() const
+QString MatCommandManager::descriptionsHelpText()
 {
     QString text;
     int longestName = 0;
     const auto doubleSpace = "  "_L1;
 
-    for (const auto *cmd : std::as_const(mCommands)) {
-        longestName = qMax(longestName, cmd->name().size());
+    for (const Entry &entry : std::as_const(mEntries)) {
+        longestName = qMax(longestName, entry.name.size());
     }
     longestName += 2; // account for the inital dobule space
-    for (const auto *cmd : std::as_const(mCommands)) {
-        QString ptext = doubleSpace + cmd->name();
+    for (Entry &entry : mEntries) {
+        QString ptext = doubleSpace + entry.name;
         ptext = ptext.leftJustified(longestName, u' ');
-        ptext += doubleSpace + cmd->description() + u'\n';
+        ptext += doubleSpace + create(&entry)->description() + u'\n';
         text.append(ptext);
     }
     return text;
@@ -22,15 +22,23 @@
 #define MATCOMMANDMANAGER_H
 
 #include <QList>
+#include <QString>
+
+#include <functional>
 
 class MatCommandInterface;
 
 /*!
  * \brief The MatCommandManager class
+ *
+ * Commands are registered by name with a factory and only created when they
+ * are looked up, so a run sets up the one command it executes.
  */
 class MatCommandManager {
 
 public:
+    using Factory = std::function<MatCommandInterface *()>;
+
     /*!
      * \brief MatCommandManager
      */
@@ -43,24 +51,41 @@ public:
 
     /*!
      * \brief add
-     * \param cmd
+     * \param name The command name
+     * \param factory Creates the command, called at most once
      */
-    void add(MatCommandInterface *cmd);
+    void add(const QString &name, const Factory &factory);
 
     /*!
-     * \brief commands
-     * \return
+     * \brief contains
+     * \param name
+     * \return true if a command named \a name is registered
      */
-    QList<MatCommandInterface *> commands() const;
+    bool contains(const QString &name) const;
 
     /*!
-     * \brief descriptionsHelpText
+     * \brief command
+     * \param name
+     * \return The command named \a name, created on first use, or nullptr
+     */
+    MatCommandInterface *command(const QString &name);
+
+    /*!
+     * \brief descriptionsHelpText Creates every command for its description
      * \return
      */
-    QString descriptionsHelpText() const;
+    QString descriptionsHelpText();
 
 private:
-    QList <MatCommandInterface *> mCommands;
+    struct Entry {
+        QString name;
+        Factory factory;
+        MatCommandInterface *command;
+    };
+
+    MatCommandInterface *create(Entry *entry);
+
+    QList<Entry> mEntries;
 };
 
 #endif // MATCOMMANDMANAGER_H
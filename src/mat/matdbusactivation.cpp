@@ -0,0 +1,83 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "matdbusactivation.h"
+
+#include "xdgdesktopfile.h"
+
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QStringList>
+#include <QVariantMap>
+
+using namespace Qt::Literals::StringLiterals;
+
+// The bus may have to start the application
+static constexpr int CallTimeout = 25 * 1000;
+
+bool MatDBusActivation::isActivatable(const XdgDesktopFile &app)
+{
+    return app.value(u"DBusActivatable"_s).toBool();
+}
+
+bool MatDBusActivation::open(const QString &desktopId, const QList<QUrl> &urls)
+{
+    QString busName = desktopId;
+    if (busName.endsWith(".desktop"_L1))
+        busName.chop(8);
+    if (busName.isEmpty())
+        return false;
+
+    QDBusConnection bus = QDBusConnection::sessionBus();
+    if (!bus.isConnected())
+        return false;
+
+    QStringList uris;
+    uris.reserve(urls.size());
+    for (const QUrl &url : urls)
+        uris.append(url.toString(QUrl::FullyEncoded));
+
+    QVariantMap platformData;
+    const QString startupId = qEnvironmentVariable("DESKTOP_STARTUP_ID");
+    if (!startupId.isEmpty())
+        platformData.insert(u"desktop-startup-id"_s, startupId);
+    const QString activationToken = qEnvironmentVariable("XDG_ACTIVATION_TOKEN");
+    if (!activationToken.isEmpty())
+        platformData.insert(u"activation-token"_s, activationToken);
+
+    QDBusMessage message = QDBusMessage::createMethodCall(busName, objectPath(busName),
+                                                          u"org.freedesktop.Application"_s,
+                                                          uris.isEmpty() ? u"Activate"_s : u"Open"_s);
+    if (!uris.isEmpty())
+        message << uris;
+    message << platformData;
+
+    const QDBusMessage reply = bus.call(message, QDBus::Block, CallTimeout);
+    return reply.type() == QDBusMessage::ReplyMessage;
+}
+
+QString MatDBusActivation::objectPath(const QString &busName)
+{
+    QString path = busName;
+    path.prepend(u'/');
+    path.replace(u'.', u'/');
+    path.replace(u'-', u'_');
+    return path;
+}
@@ -0,0 +1,69 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#ifndef MATDBUSACTIVATION_H
+#define MATDBUSACTIVATION_H
+
+#include <QList>
+#include <QString>
+#include <QUrl>
+
+class XdgDesktopFile;
+
+/*!
+ * \brief The MatDBusActivation class launches DBusActivatable applications
+ * through the org.freedesktop.Application interface.
+ *
+ * For a running single instance application that is one method call instead
+ * of a process start.
+ */
+class MatDBusActivation {
+
+public:
+    /*!
+     * \brief isActivatable
+     * \param app
+     * \return true if \a app declares DBusActivatable=true
+     */
+    static bool isActivatable(const XdgDesktopFile &app);
+
+    /*!
+     * \brief open Calls org.freedesktop.Application.Open
+     *
+     * The application runs in another directory, local files must be
+     * absolute file URLs. Whether a target is a file or a URL is up to the
+     * caller, an existing file may well look like a URL.
+     * \param desktopId The desktop file id of the application
+     * \param urls The targets, Activate is called if empty
+     * \return false if the call failed and the caller should fall back to
+     * running the Exec key
+     */
+    static bool open(const QString &desktopId, const QList<QUrl> &urls);
+
+    /*!
+     * \brief objectPath
+     * \param busName
+     * \return The object path for \a busName, as defined by the Desktop Entry
+     * spec
+     */
+    static QString objectPath(const QString &busName);
+};
+
+#endif // MATDBUSACTIVATION_H
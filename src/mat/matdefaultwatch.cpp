@@ -0,0 +1,71 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "matdefaultwatch.h"
+
+#include "matwatcher.h"
+
+#include <QCoreApplication>
+
+#include <iostream>
+
+MatDefaultWatch::MatDefaultWatch(QObject *parent)
+    : QObject(parent),
+      mResolver({&mLayers}, {&mDesktopDb}),
+      mWatcher(new MatWatcher(this)),
+      mReported(false)
+{
+    mWatcher->setMimeAppsLayers(&mLayers);
+    mWatcher->setDesktopDb(&mDesktopDb);
+    connect(mWatcher, &MatWatcher::changed, this, &MatDefaultWatch::check);
+}
+
+MatDefaultWatch::~MatDefaultWatch() = default;
+
+void MatDefaultWatch::watchFile(const QString &fileName)
+{
+    mWatcher->watchFile(fileName);
+}
+
+int MatDefaultWatch::exec(const Resolve &resolve, const Report &report)
+{
+    if (!mWatcher->isValid()) {
+        std::cerr << "Could not watch for changes\n";
+        return EXIT_FAILURE;
+    }
+
+    mResolve = resolve;
+    mReport = report;
+    // Watch first, a change while resolving is then not missed
+    mWatcher->watchDefaultDirs();
+    check();
+    return QCoreApplication::exec();
+}
+
+void MatDefaultWatch::check()
+{
+    const QString value = mResolve();
+    if (mReported && value == mValue)
+        return;
+
+    mValue = value;
+    mReported = true;
+    mReport(value);
+}
@@ -0,0 +1,99 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#ifndef MATDEFAULTWATCH_H
+#define MATDEFAULTWATCH_H
+
+#include "matdesktopdb.h"
+#include "matmimeappslist.h"
+#include "matresolver.h"
+
+#include <QObject>
+#include <QString>
+
+#include <functional>
+
+class MatWatcher;
+
+/*!
+ * \brief The MatDefaultWatch class reports a default application, then every
+ * change of it, until the process is killed.
+ *
+ * The value is resolved again only after MatWatcher noticed a change in the
+ * mimeapps.list layers, the desktop files or a watched file, and reported
+ * only if it differs from the previous one. How it's resolved is up to the
+ * Resolve callback, which should match what the command prints without
+ * --watch.
+ */
+class MatDefaultWatch : public QObject {
+    Q_OBJECT
+
+public:
+    //! Returns the current value, e.g. the default app desktop file
+    using Resolve = std::function<QString()>;
+    //! Prints a new value
+    using Report = std::function<void(const QString &value)>;
+
+    /*!
+     * \brief MatDefaultWatch
+     * \param parent
+     */
+    explicit MatDefaultWatch(QObject *parent = nullptr);
+
+    /*!
+     * \brief ~MatDefaultWatch
+     */
+    ~MatDefaultWatch() override;
+
+    /*!
+     * \brief resolver
+     * \return A resolver over the watched, and always current, layers and
+     * desktop files
+     */
+    inline const MatResolver *resolver() const { return &mResolver; }
+
+    /*!
+     * \brief watchFile Also resolves again when \a fileName changes
+     * \param fileName
+     */
+    void watchFile(const QString &fileName);
+
+    /*!
+     * \brief exec Runs the event loop
+     * \param resolve
+     * \param report
+     * \return The exit code, EXIT_FAILURE if inotify isn't available
+     */
+    int exec(const Resolve &resolve, const Report &report);
+
+private:
+    void check();
+
+    MatMimeAppsLayers mLayers;
+    MatDesktopDb mDesktopDb;
+    MatResolver mResolver;
+    MatWatcher *mWatcher;
+    Resolve mResolve;
+    Report mReport;
+    QString mValue;
+    bool mReported;
+};
+
+#endif // MATDEFAULTWATCH_H
@@ -0,0 +1,317 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "matdesktopdb.h"
+
+#include "xdgdirs.h"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QStandardPaths>
+
+#include <unistd.h>
+
+using namespace Qt::Literals::StringLiterals;
+
+MatDesktopDb::MatDesktopDb()
+    : MatDesktopDb(applicationsDirs())
+{
+}
+
+MatDesktopDb::MatDesktopDb(const QStringList &dirs)
+    : mScanned(false),
+      mMimeIndexValid(false)
+{
+    // As the file names of invalidateFile() are matched against them
+    mDirs.reserve(dirs.size());
+    for (const QString &dir : dirs)
+        mDirs.append(QDir::cleanPath(dir));
+    mDirs.removeDuplicates();
+}
+
+MatDesktopDb::~MatDesktopDb() = default;
+
+QStringList MatDesktopDb::applicationsDirs()
+{
+    QStringList dirs;
+    dirs.append(XdgDirs::dataHome(false) + "/applications"_L1);
+    const QStringList dataDirs = XdgDirs::dataDirs();
+    for (const QString &dir : dataDirs)
+        dirs.append(dir + "/applications"_L1);
+    dirs.removeDuplicates();
+    return dirs;
+}
+
+QString MatDesktopDb::desktopId(const QString &dir, const QString &fileName)
+{
+    QString id = fileName.mid(dir.size());
+    while (id.startsWith(u'/'))
+        id.remove(0, 1);
+    id.replace(u'/', u'-');
+    return id;
+}
+
+QHash<QString, QString> MatDesktopDb::fileIndex(const QStringList &dirs)
+{
+    QHash<QString, QString> files;
+    for (const QString &dir : dirs) {
+        QDirIterator it(dir, QStringList() << u"*.desktop"_s, QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            const QString fileName = it.next();
+            const QString id = desktopId(dir, fileName);
+            if (!files.contains(id)) // shadowed by a more important directory
+                files.insert(id, fileName);
+        }
+    }
+    return files;
+}
+
+QList<const MatDesktopEntry *> MatDesktopDb::entries()
+{
+    scan();
+
+    QList<const MatDesktopEntry *> list;
+    list.reserve(mEntries.size());
+    for (const MatDesktopEntry &entry : std::as_const(mEntries)) {
+        if (!entry.id.isEmpty()) // skip removed entries
+            list.append(&entry);
+    }
+    return list;
+}
+
+const MatDesktopEntry *MatDesktopDb::entry(const QString &id)
+{
+    scan();
+
+    const auto it = mIndex.constFind(id);
+    if (it == mIndex.constEnd())
+        return nullptr;
+    return &mEntries.at(it.value());
+}
+
+QList<const MatDesktopEntry *> MatDesktopDb::entriesForMimeType(const QString &mimeType)
+{
+    scan();
+    buildMimeIndex();
+
+    QList<const MatDesktopEntry *> list;
+    const QList<qsizetype> indexes = mMimeIndex.value(mimeType);
+    list.reserve(indexes.size());
+    for (const qsizetype i : indexes)
+        list.append(&mEntries.at(i));
+    return list;
+}
+
+bool MatDesktopDb::hasFile(const QString &id)
+{
+    scan();
+    return mFiles.contains(id);
+}
+
+void MatDesktopDb::scan()
+{
+    if (mScanned)
+        return;
+    mScanned = true;
+
+    for (const QString &dir : std::as_const(mDirs)) {
+        QDirIterator it(dir, QStringList() << u"*.desktop"_s, QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            const QString fileName = it.next();
+            const QString id = desktopId(dir, fileName);
+            if (mFiles.contains(id)) // shadowed by a more important directory
+                continue;
+            mFiles.insert(id);
+
+            MatDesktopEntry entry;
+            if (!loadEntry(id, fileName, &entry))
+                continue;
+
+            mIndex.insert(id, mEntries.size());
+            mEntries.append(entry);
+        }
+    }
+}
+
+void MatDesktopDb::buildMimeIndex()
+{
+    if (mMimeIndexValid)
+        return;
+    mMimeIndexValid = true;
+
+    mMimeIndex.clear();
+    for (qsizetype i = 0; i < mEntries.size(); ++i) {
+        const MatDesktopEntry &entry = mEntries.at(i);
+        if (entry.id.isEmpty())
+            continue;
+        for (const QString &mimeType : entry.mimeTypes)
+            mMimeIndex[mimeType].append(i);
+    }
+}
+
+void MatDesktopDb::invalidateFile(const QString &fileName)
+{
+    if (!mScanned)
+        return;
+
+    const QString cleanFileName = QDir::cleanPath(fileName);
+    QString id;
+    for (const QString &dir : std::as_const(mDirs)) {
+        if (cleanFileName.startsWith(dir + u'/')) {
+            id = desktopId(dir, cleanFileName);
+            break;
+        }
+    }
+    if (id.isEmpty())
+        return;
+
+    // Not only the same relative path, "kde/foo.desktop" and
+    // "kde-foo.desktop" have the same id
+    const QStringList relativePaths = idPaths(id);
+    MatDesktopEntry entry;
+    bool exists = false;
+    bool found = false;
+    for (const QString &dir : std::as_const(mDirs)) {
+        const QString candidate = idFile(dir, id, relativePaths);
+        if (!candidate.isEmpty()) {
+            exists = true;
+            found = loadEntry(id, candidate, &entry);
+            break; // the most important file decides, even if it's hidden
+        }
+    }
+
+    if (exists)
+        mFiles.insert(id);
+    else
+        mFiles.remove(id);
+
+    const auto it = mIndex.constFind(id);
+    if (it != mIndex.constEnd()) {
+        if (found) {
+            mEntries[it.value()] = entry;
+        } else {
+            mEntries[it.value()] = MatDesktopEntry(); // keep the indexes of the others
+            mIndex.erase(it);
+        }
+    } else if (found) {
+        mIndex.insert(id, mEntries.size());
+        mEntries.append(entry);
+    }
+    mMimeIndexValid = false;
+}
+
+void MatDesktopDb::reset()
+{
+    mScanned = false;
+    mMimeIndexValid = false;
+    mEntries.clear();
+    mIndex.clear();
+    mMimeIndex.clear();
+    mFiles.clear();
+    mTryExec.clear();
+}
+
+// The relative paths whose id is \a id, each '-' being a '-' or a '/'. Too
+// many dashes give an empty list, the directory is walked instead.
+QStringList MatDesktopDb::idPaths(const QString &id)
+{
+    static constexpr int MaxDashes = 8;
+
+    QList<qsizetype> dashes;
+    for (qsizetype i = 0; i < id.size(); ++i) {
+        if (id.at(i) == u'-')
+            dashes.append(i);
+    }
+    if (dashes.size() > MaxDashes)
+        return QStringList();
+
+    QStringList paths;
+    const quint32 count = 1u << dashes.size();
+    paths.reserve(count);
+    for (quint32 mask = 0; mask < count; ++mask) {
+        QString path = id;
+        for (qsizetype bit = 0; bit < dashes.size(); ++bit) {
+            if (mask & (1u << bit))
+                path[dashes.at(bit)] = u'/';
+        }
+        if (!path.startsWith(u'/') && !path.contains("//"_L1) && !path.endsWith(u'/'))
+            paths.append(path);
+    }
+    return paths;
+}
+
+QString MatDesktopDb::idFile(const QString &dir, const QString &id, const QStringList &relativePaths)
+{
+    if (relativePaths.isEmpty()) {
+        QDirIterator it(dir, QStringList() << u"*.desktop"_s, QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            const QString fileName = it.next();
+            if (desktopId(dir, fileName) == id)
+                return fileName;
+        }
+        return QString();
+    }
+
+    for (const QString &relativePath : relativePaths) {
+        const QString fileName = dir + u'/' + relativePath;
+        if (QFileInfo(fileName).isFile())
+            return fileName;
+    }
+    return QString();
+}
+
+bool MatDesktopDb::loadEntry(const QString &id, const QString &fileName, MatDesktopEntry *entry)
+{
+    // One scanner for every file, its read buffer is reused
+    if (!mScanner.scanFile(fileName) || !mScanner.hasDesktopEntry())
+        return false;
+    if (mScanner.value(MatDesktopScanner::TypeKey) != "Application")
+        return false;
+    if (mScanner.boolValue(MatDesktopScanner::HiddenKey))
+        return false;
+    if (!mScanner.value(MatDesktopScanner::TryExecKey).isEmpty()
+            && !tryExec(mScanner.stringValue(MatDesktopScanner::TryExecKey))) {
+        return false;
+    }
+
+    entry->id = id;
+    entry->fileName = fileName;
+    entry->categories = mScanner.listValue(MatDesktopScanner::CategoriesKey);
+    entry->mimeTypes = mScanner.listValue(MatDesktopScanner::MimeTypeKey);
+    return true;
+}
+
+bool MatDesktopDb::tryExec(const QString &program)
+{
+    // Many entries share a TryExec program, e.g. a suite's launchers
+    const auto it = mTryExec.constFind(program);
+    if (it != mTryExec.constEnd())
+        return it.value();
+
+    bool found;
+    if (program.startsWith(u'/'))
+        found = ::access(QFile::encodeName(program).constData(), X_OK) == 0;
+    else
+        found = !QStandardPaths::findExecutable(program).isEmpty();
+    mTryExec.insert(program, found);
+    return found;
+}
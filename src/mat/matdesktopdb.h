@@ -0,0 +1,170 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#ifndef MATDESKTOPDB_H
+#define MATDESKTOPDB_H
+
+#include "matdesktopscanner.h"
+
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+/*!
+ * \brief The MatDesktopEntry struct holds the desktop entry keys qtxdg-mat
+ * needs to classify an application without keeping an XdgDesktopFile around.
+ */
+struct MatDesktopEntry {
+    QString id;
+    QString fileName;
+    QStringList categories;
+    QStringList mimeTypes;
+};
+
+/*!
+ * \brief The MatDesktopDb class is a process wide index of the installed
+ * applications.
+ *
+ * Like XdgDesktopFile::isSuitable(), hidden entries and entries whose TryExec
+ * program isn't installed are left out.
+ *
+ * The applications directories are scanned once, on first use, and every
+ * consumer shares the result. A database can also be built over a given set
+ * of directories, e.g. only the system ones or only one user's.
+ */
+class MatDesktopDb {
+
+public:
+    /*!
+     * \brief MatDesktopDb Indexes the applicationsDirs() of the environment
+     */
+    MatDesktopDb();
+
+    /*!
+     * \brief MatDesktopDb
+     * \param dirs The applications directories, most important first
+     */
+    explicit MatDesktopDb(const QStringList &dirs);
+
+    /*!
+     * \brief ~MatDesktopDb
+     */
+    virtual ~MatDesktopDb();
+
+    /*!
+     * \brief setOwner Only indexes desktop files \a uid owns
+     * \param uid The owner, -1 accepts any
+     * \sa MatDesktopScanner::setOwner()
+     */
+    inline void setOwner(qint64 uid) { mScanner.setOwner(uid); }
+
+    /*!
+     * \brief entries
+     * \return All the installed applications, in XDG_DATA_DIRS precedence
+     */
+    QList<const MatDesktopEntry *> entries();
+
+    /*!
+     * \brief entry
+     * \param id The desktop file id
+     * \return The entry or nullptr if \a id isn't installed
+     */
+    const MatDesktopEntry *entry(const QString &id);
+
+    /*!
+     * \brief entriesForMimeType
+     * \param mimeType
+     * \return The applications declaring \a mimeType in their MimeType key
+     */
+    QList<const MatDesktopEntry *> entriesForMimeType(const QString &mimeType);
+
+    /*!
+     * \brief hasFile
+     * \param id
+     * \return true if a desktop file named \a id exists, even a hidden or
+     * invalid one. It shadows the same id in less important databases.
+     */
+    bool hasFile(const QString &id);
+
+    /*!
+     * \brief dirs
+     * \return The indexed applications directories
+     */
+    inline QStringList dirs() const { return mDirs; }
+
+    /*!
+     * \brief invalidateFile Reloads the entry of one desktop file
+     *
+     * The entry is replaced by the most important remaining file with the same
+     * id, if any, whatever its subdirectory: "kde/foo.desktop" and
+     * "kde-foo.desktop" are the same application. Entry pointers previously
+     * handed out are invalidated.
+     * \param fileName A desktop file in one of the applicationsDirs()
+     */
+    void invalidateFile(const QString &fileName);
+
+    /*!
+     * \brief reset Drops everything, the next use rescans
+     */
+    void reset();
+
+    /*!
+     * \brief applicationsDirs
+     * \return The applications directories, most important first
+     */
+    static QStringList applicationsDirs();
+
+    /*!
+     * \brief desktopId
+     * \param dir An applications directory
+     * \param fileName A desktop file below \a dir
+     * \return The desktop file id
+     */
+    static QString desktopId(const QString &dir, const QString &fileName);
+
+    /*!
+     * \brief fileIndex Lists the desktop files without loading any
+     * \param dirs The applications directories, most important first
+     * \return The desktop id to file name map, shadowed files left out
+     */
+    static QHash<QString, QString> fileIndex(const QStringList &dirs);
+
+private:
+    void scan();
+    void buildMimeIndex();
+    bool loadEntry(const QString &id, const QString &fileName, MatDesktopEntry *entry);
+    bool tryExec(const QString &program);
+    static QStringList idPaths(const QString &id);
+    static QString idFile(const QString &dir, const QString &id, const QStringList &relativePaths);
+
+    QStringList mDirs;
+    bool mScanned;
+    bool mMimeIndexValid;
+    QList<MatDesktopEntry> mEntries;
+    QHash<QString, qsizetype> mIndex;
+    QHash<QString, QList<qsizetype>> mMimeIndex;
+    QSet<QString> mFiles;
+    QHash<QString, bool> mTryExec;
+    MatDesktopScanner mScanner;
+};
+
+#endif // MATDESKTOPDB_H
@@ -0,0 +1,230 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "matdesktopscanner.h"
+
+#include <QFile>
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const struct {
+    QByteArrayView name;
+    MatDesktopScanner::Key key;
+} keys[] = {
+    { "Type", MatDesktopScanner::TypeKey },
+    { "Hidden", MatDesktopScanner::HiddenKey },
+    { "Categories", MatDesktopScanner::CategoriesKey },
+    { "MimeType", MatDesktopScanner::MimeTypeKey },
+    { "Exec", MatDesktopScanner::ExecKey },
+    { "TryExec", MatDesktopScanner::TryExecKey },
+    { "DBusActivatable", MatDesktopScanner::DBusActivatableKey }
+};
+
+// The escapes of the string type, \s \n \t \r and \\, other ones are kept
+char unescaped(char c)
+{
+    switch (c) {
+    case 's':
+        return ' ';
+    case 'n':
+        return '\n';
+    case 't':
+        return '\t';
+    case 'r':
+        return '\r';
+    default:
+        return c;
+    }
+}
+
+} // namespace
+
+bool MatDesktopScanner::scanFile(const QString &fileName)
+{
+    mBuffer.resize(0);
+    scan(QByteArrayView());
+
+    // Checked on the opened file, it can't be swapped after the check.
+    // O_NONBLOCK keeps a FIFO from blocking the reader.
+    const int fd = ::open(QFile::encodeName(fileName).constData(), O_RDONLY | O_CLOEXEC | O_NOCTTY | O_NONBLOCK);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size > MaxFileSize
+            || (mOwner >= 0 && qint64(st.st_uid) != mOwner)) {
+        ::close(fd);
+        return false;
+    }
+
+    // Read, not mapped: a file truncated while it's scanned, e.g. rewritten
+    // in place by an editor, just reads short instead of raising SIGBUS
+    if (st.st_size > 0)
+        mBuffer.reserve(qsizetype(st.st_size) + 1);
+
+    bool ok = true;
+    for (;;) {
+        if (mBuffer.size() == mBuffer.capacity())
+            mBuffer.reserve(qMax<qsizetype>(4096, mBuffer.capacity() * 2));
+        const qsizetype size = mBuffer.size();
+        mBuffer.resize(mBuffer.capacity());
+        const ssize_t n = ::read(fd, mBuffer.data() + size, size_t(mBuffer.size() - size));
+        if (n < 0 && errno == EINTR) {
+            mBuffer.resize(size);
+            continue;
+        }
+        mBuffer.resize(size + qMax<qsizetype>(n, 0));
+        if (n <= 0 || mBuffer.size() > MaxFileSize) { // grown since the fstat()
+            ok = n == 0;
+            break;
+        }
+    }
+    ::close(fd);
+
+    if (!ok) {
+        mBuffer.resize(0);
+        return false;
+    }
+    scan(mBuffer);
+    return true;
+}
+
+void MatDesktopScanner::scan(QByteArrayView data)
+{
+    for (QByteArrayView &value : mValues)
+        value = QByteArrayView();
+    mHasDesktopEntry = false;
+
+    const char *p = data.data();
+    const char *const end = p + data.size();
+    bool inDesktopEntry = false;
+
+    while (p < end) {
+        const void *nl = std::memchr(p, '\n', size_t(end - p));
+        const char *eol = nl != nullptr ? static_cast<const char *>(nl) : end;
+        const QByteArrayView line = QByteArrayView(p, eol - p).trimmed();
+        p = eol < end ? eol + 1 : end;
+
+        if (line.isEmpty() || line.front() == '#')
+            continue;
+
+        if (line.front() == '[') {
+            if (mHasDesktopEntry)
+                break; // only the actions and extensions follow
+            inDesktopEntry = line == "[Desktop Entry]";
+            mHasDesktopEntry = inDesktopEntry;
+            continue;
+        }
+
+        if (!inDesktopEntry)
+            continue;
+
+        const qsizetype eq = line.indexOf('=');
+        if (eq <= 0)
+            continue;
+
+        const QByteArrayView name = line.first(eq).trimmed();
+        for (const auto &k : keys) {
+            if (name == k.name) {
+                if (mValues[k.key].isNull())
+                    mValues[k.key] = line.sliced(eq + 1).trimmed();
+                break;
+            }
+        }
+    }
+}
+
+QStringList MatDesktopScanner::listValue(Key key) const
+{
+    QStringList list;
+    const QByteArrayView raw = mValues[key];
+    QByteArray item;
+    for (qsizetype i = 0; i < raw.size(); ++i) {
+        const char c = raw.at(i);
+        if (c == '\\' && i + 1 < raw.size()) {
+            item.append(unescaped(raw.at(++i)));
+        } else if (c == ';') {
+            if (!item.isEmpty())
+                list.append(QString::fromUtf8(item));
+            item.clear();
+        } else {
+            item.append(c);
+        }
+    }
+    if (!item.isEmpty())
+        list.append(QString::fromUtf8(item));
+    return list;
+}
+
+QString MatDesktopScanner::stringValue(Key key) const
+{
+    const QByteArrayView raw = mValues[key];
+    QByteArray value;
+    value.reserve(raw.size());
+    for (qsizetype i = 0; i < raw.size(); ++i) {
+        const char c = raw.at(i);
+        if (c == '\\' && i + 1 < raw.size())
+            value.append(unescaped(raw.at(++i)));
+        else
+            value.append(c);
+    }
+    return QString::fromUtf8(value);
+}
+
+QString MatDesktopScanner::program() const
+{
+    // The string escapes first, then the Exec quoting rules
+    const QByteArrayView raw = mValues[ExecKey];
+    QByteArray exec;
+    exec.reserve(raw.size());
+    for (qsizetype i = 0; i < raw.size(); ++i) {
+        const char c = raw.at(i);
+        if (c == '\\' && i + 1 < raw.size() && raw.at(i + 1) != '"' && raw.at(i + 1) != '`'
+                && raw.at(i + 1) != '$') {
+            exec.append(unescaped(raw.at(++i)));
+        } else {
+            exec.append(c);
+        }
+    }
+
+    qsizetype i = 0;
+    while (i < exec.size() && (exec.at(i) == ' ' || exec.at(i) == '\t'))
+        ++i;
+
+    QByteArray program;
+    if (i < exec.size() && exec.at(i) == '"') {
+        for (++i; i < exec.size() && exec.at(i) != '"'; ++i) {
+            if (exec.at(i) == '\\' && i + 1 < exec.size())
+                ++i;
+            program.append(exec.at(i));
+        }
+    } else {
+        for (; i < exec.size() && exec.at(i) != ' ' && exec.at(i) != '\t'; ++i)
+            program.append(exec.at(i));
+    }
+    return QString::fromUtf8(program);
+}
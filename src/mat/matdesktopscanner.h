@@ -0,0 +1,129 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#ifndef MATDESKTOPSCANNER_H
+#define MATDESKTOPSCANNER_H
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QtGlobal>
+#include <QString>
+#include <QStringList>
+
+/*!
+ * \brief The MatDesktopScanner class reads the few [Desktop Entry] keys
+ * qtxdg-mat needs, from one read() of the file into a reused buffer.
+ *
+ * Unlike XdgDesktopFile, nothing is decoded but the values of those keys,
+ * and localized keys, actions and other groups are skipped. Line boundaries
+ * are found with memchr().
+ */
+class MatDesktopScanner {
+
+public:
+    MatDesktopScanner() = default;
+    Q_DISABLE_COPY_MOVE(MatDesktopScanner)
+
+    enum Key {
+        TypeKey,
+        HiddenKey,
+        CategoriesKey,
+        MimeTypeKey,
+        ExecKey,
+        TryExecKey,
+        DBusActivatableKey,
+        KeyCount
+    };
+
+    //! Larger files aren't desktop files, they aren't read
+    static constexpr qsizetype MaxFileSize = 1024 * 1024;
+
+    /*!
+     * \brief setOwner Only reads files \a uid owns
+     * \param uid The owner, -1 accepts any
+     * \sa MatMimeAppsList::setOwner()
+     */
+    inline void setOwner(qint64 uid) { mOwner = uid; }
+
+    /*!
+     * \brief scanFile Reads \a fileName and scans it
+     *
+     * Only a regular file of at most MaxFileSize bytes is read, a FIFO or a
+     * device doesn't block the reader.
+     * Values are views into the read contents, valid until the next scan.
+     * \param fileName
+     * \return false if the file can't be read
+     */
+    bool scanFile(const QString &fileName);
+
+    /*!
+     * \brief scan
+     * \param data The contents of a desktop file, it must outlive the values
+     */
+    void scan(QByteArrayView data);
+
+    /*!
+     * \brief hasDesktopEntry
+     * \return true if the file has a [Desktop Entry] group
+     */
+    inline bool hasDesktopEntry() const { return mHasDesktopEntry; }
+
+    /*!
+     * \brief value
+     * \param key
+     * \return The raw, still escaped, value of \a key or a null view
+     */
+    inline QByteArrayView value(Key key) const { return mValues[key]; }
+
+    /*!
+     * \brief boolValue
+     * \param key
+     * \return true if \a key is "true"
+     */
+    inline bool boolValue(Key key) const { return mValues[key] == "true"; }
+
+    /*!
+     * \brief stringValue
+     * \param key
+     * \return The unescaped value of \a key
+     */
+    QString stringValue(Key key) const;
+
+    /*!
+     * \brief listValue
+     * \param key
+     * \return The unescaped entries of a ';' separated list
+     */
+    QStringList listValue(Key key) const;
+
+    /*!
+     * \brief program
+     * \return The unquoted program of the Exec key, empty if none
+     */
+    QString program() const;
+
+private:
+    QByteArrayView mValues[KeyCount];
+    bool mHasDesktopEntry = false;
+    qint64 mOwner = -1;
+    QByteArray mBuffer;
+};
+
+#endif // MATDESKTOPSCANNER_H
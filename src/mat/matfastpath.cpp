@@ -0,0 +1,151 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+
+#include "matfastpath.h"
+
+#include "defcategorymatcommand.h"
+#include "matcategoryengine.h"
+#include "matdesktopdb.h"
+#include "matmimeappslist.h"
+#include "matoutput.h"
+#include "matresolver.h"
+
+#include <QString>
+
+using namespace Qt::Literals::StringLiterals;
+
+struct FastPathData {
+    FastPathData() : format(MatOutput::TextFormat) {}
+
+    QString command;
+    QStringList positional;
+    MatOutput::Format format;
+};
+
+// The subset of the QCommandLineParser syntax the fast commands take. Any
+// other option makes the regular parser handle, and report, the arguments.
+static bool parse(const QStringList &arguments, FastPathData *query)
+{
+    bool positionalOnly = false;
+    QStringList positional;
+    for (qsizetype i = 0; i < arguments.size(); ++i) {
+        const QString &arg = arguments.at(i);
+        if (positionalOnly || !arg.startsWith(u'-') || arg.size() == 1) {
+            positional.append(arg);
+        } else if (arg == "--"_L1) {
+            positionalOnly = true;
+        } else if (arg == "--no-localize"_L1) {
+            // a no-op, as in the regular path
+        } else if (arg == "--format"_L1) {
+            if (++i == arguments.size() || !MatOutput::formatFromName(arguments.at(i), &query->format))
+                return false;
+        } else if (arg.startsWith("--format="_L1)) {
+            if (!MatOutput::formatFromName(arg.mid(9), &query->format))
+                return false;
+        } else {
+            return false;
+        }
+    }
+
+    if (positional.isEmpty())
+        return false;
+
+    query->command = positional.takeFirst();
+    query->positional = positional;
+    return true;
+}
+
+// A batch writes a record for every mimetype, an empty id line for no
+// default, a single get only an answer
+static void writeDefault(MatOutput *output, bool batch, const QString &mimeType, const QString &id, const QString &fileName)
+{
+    if (batch)
+        output->write({{"mimetype"_L1, mimeType}, {"id"_L1, id}, {"file"_L1, fileName}},
+                      id.isEmpty() ? QStringView(u"") : QStringView(id));
+    else if (!fileName.isEmpty())
+        output->write({{"mimetype"_L1, mimeType}, {"id"_L1, id}, {"file"_L1, fileName}}, id);
+}
+
+// Mirrors the get of DefAppMatCommand
+static int defApp(const FastPathData &query)
+{
+    MatOutput output;
+    output.setFormat(query.format);
+
+    const bool batch = query.positional.size() > 1;
+    MatMimeAppsLayers layers;
+    MatDesktopDb db;
+    const MatResolver resolver({&layers}, {&db});
+    for (const QString &mimeType : query.positional) {
+        const MatDesktopEntry *app = resolver.defaultApp(mimeType);
+        writeDefault(&output, batch, mimeType, app != nullptr ? app->id : QString(),
+                     app != nullptr ? app->fileName : QString());
+    }
+    output.flush();
+    return EXIT_SUCCESS;
+}
+
+// Mirrors the get of DefCategoryMatCommand
+static int defCategory(MatCategoryEngine *engine, const MatCategory &category, const FastPathData &query)
+{
+    MatOutput output;
+    output.setFormat(query.format);
+
+    const QString fileName = engine->defaultAppFile(category);
+    if (!fileName.isEmpty())
+        DefCategoryMatCommand::writeApp(&output, category, fileName);
+    output.flush();
+    return EXIT_SUCCESS;
+}
+
+bool MatFastPath::isEnabled()
+{
+    return !qEnvironmentVariableIsSet("QTXDG_MAT_NO_FASTPATH");
+}
+
+bool MatFastPath::run(const QStringList &arguments, int *exitCode)
+{
+    FastPathData query;
+    if (!parse(arguments, &query))
+        return false;
+
+    if (query.command == "defapp"_L1) {
+        // A server answers gets through a socket, which wants the event loop
+        if (query.positional.isEmpty() || qEnvironmentVariableIsSet("QTXDG_MAT_SOCKET"))
+            return false;
+        *exitCode = defApp(query);
+        return true;
+    }
+
+    if (!query.command.startsWith("def-"_L1) || !query.positional.isEmpty())
+        return false;
+
+    // The site categories are only read for a def- command
+    MatCategoryEngine engine;
+    const QList<MatCategory> categories = engine.categories();
+    for (const MatCategory &category : categories) {
+        if (category.name != query.command)
+            continue;
+        *exitCode = defCategory(&engine, category, query);
+        return true;
+    }
+    return false;
+}
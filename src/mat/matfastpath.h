@@ -0,0 +1,58 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef MATFASTPATH_H
+#define MATFASTPATH_H
+
+#include <QStringList>
+
+/*!
+ * \brief The MatFastPath class answers plain read-only queries without a
+ * QCoreApplication.
+ *
+ * "defapp <mimetype>..." and "def-<category>", optionally with --format, only
+ * read files: they resolve with the same backend as the regular path,
+ * MatResolver, so their answer is the same. Their arguments are parsed
+ * here and neither the application object, with its event dispatcher, nor
+ * the commands are set up. Anything else, help and errors included, is left
+ * to the regular path.
+ *
+ * It is disabled by QTXDG_MAT_NO_FASTPATH.
+ */
+class MatFastPath {
+
+public:
+    /*!
+     * \brief isEnabled
+     * \return false if QTXDG_MAT_NO_FASTPATH is set
+     */
+    static bool isEnabled();
+
+    /*!
+     * \brief run Runs the query if it's one the fast path answers
+     * \param arguments The arguments, without the program name
+     * \param exitCode Set when the query is answered
+     * \return false if the regular path has to run the command
+     */
+    static bool run(const QStringList &arguments, int *exitCode);
+};
+
+#endif // MATFASTPATH_H
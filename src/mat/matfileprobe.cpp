@@ -0,0 +1,345 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "matfileprobe.h"
+
+#include <atomic>
+#include <cerrno>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef QTXDG_MAT_HAVE_IO_URING
+#include <liburing.h>
+
+struct MatFileProbe::Ring {
+    io_uring ring;
+};
+
+// Kernels 5.1 to 5.5 set up a ring but fail statx, openat, read and close
+// with -EINVAL. They can't be probed either, which came with those opcodes.
+static bool supportsProbeOpcodes(io_uring *ring)
+{
+    io_uring_probe *probe = io_uring_get_probe_ring(ring);
+    if (probe == nullptr)
+        return false;
+    const bool supported = io_uring_opcode_supported(probe, IORING_OP_STATX)
+            && io_uring_opcode_supported(probe, IORING_OP_OPENAT)
+            && io_uring_opcode_supported(probe, IORING_OP_READ)
+            && io_uring_opcode_supported(probe, IORING_OP_CLOSE);
+    io_uring_free_probe(probe);
+    return supported;
+}
+#else
+struct MatFileProbe::Ring {
+};
+#endif
+
+static void resetEntry(MatFileProbe::Entry *entry)
+{
+    entry->error = 0;
+    entry->mode = 0;
+    entry->header.resize(0); // keeps the capacity
+}
+
+static void probeEntry(MatFileProbe::Entry *entry, qsizetype headerSize)
+{
+    resetEntry(entry);
+
+    struct stat st;
+    if (::stat(entry->path.constData(), &st) != 0) {
+        entry->error = errno;
+        return;
+    }
+    entry->mode = st.st_mode;
+    if (headerSize == 0 || !S_ISREG(st.st_mode))
+        return;
+
+    const int fd = ::open(entry->path.constData(), O_RDONLY | O_CLOEXEC | O_NOCTTY);
+    if (fd < 0)
+        return; // it exists but can't be read, there's no header
+
+    entry->header.resize(headerSize);
+    qsizetype size = 0;
+    while (size < headerSize) {
+        const ssize_t n = ::read(fd, entry->header.data() + size, size_t(headerSize - size));
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            break;
+        size += n;
+    }
+    entry->header.resize(size);
+    ::close(fd);
+}
+
+MatFileProbe::MatFileProbe(int queueDepth, qsizetype headerSize)
+    : mQueueDepth(qMax(1, queueDepth)),
+      mHeaderSize(qMax<qsizetype>(0, headerSize)),
+      mRing(nullptr),
+      mRingChecked(false)
+{
+    mPool.setMaxThreadCount(mQueueDepth);
+}
+
+MatFileProbe::~MatFileProbe()
+{
+#ifdef QTXDG_MAT_HAVE_IO_URING
+    if (mRing != nullptr) {
+        io_uring_queue_exit(&mRing->ring);
+        delete mRing;
+    }
+#endif
+}
+
+void MatFileProbe::setUpRing()
+{
+    mRingChecked = true;
+
+#ifdef QTXDG_MAT_HAVE_IO_URING
+    if (qEnvironmentVariableIsSet("QTXDG_MAT_NO_IO_URING"))
+        return;
+
+    auto *ring = new Ring;
+    if (io_uring_queue_init(unsigned(mQueueDepth), &ring->ring, 0) != 0) {
+        delete ring; // an old kernel, a seccomp filter, a disabled sysctl...
+    } else if (!supportsProbeOpcodes(&ring->ring)) {
+        io_uring_queue_exit(&ring->ring);
+        delete ring;
+    } else {
+        mRing = ring;
+    }
+#endif
+}
+
+void MatFileProbe::run(QList<Entry> *entries)
+{
+    for (Entry &entry : *entries)
+        resetEntry(&entry);
+
+    // A single file, e.g. "mimetype foo", isn't worth the ring setup
+    if (entries->size() > 1 && !mRingChecked)
+        setUpRing();
+
+    QList<bool> done(entries->size(), false);
+    if (mRing != nullptr && runRing(entries, &done))
+        return;
+    runThreads(entries, done);
+}
+
+const char *MatFileProbe::backend() const
+{
+    return mRing != nullptr ? "io_uring" : "threads";
+}
+
+bool MatFileProbe::runRing(QList<Entry> *entries, QList<bool> *done)
+{
+#ifdef QTXDG_MAT_HAVE_IO_URING
+    // Every slot has at most one operation queued, so the ring never overflows
+    enum Stage {
+        StatxStage,
+        OpenStage,
+        ReadStage,
+        CloseStage
+    };
+    struct Slot {
+        qsizetype entry;
+        Stage stage;
+        int fd;
+        struct statx stx;
+    };
+
+    io_uring *ring = &mRing->ring;
+    Entry *const data = entries->data();
+    std::vector<Slot> slots(size_t(mQueueDepth));
+    std::vector<int> freeSlots;
+    freeSlots.reserve(slots.size());
+    for (int s = mQueueDepth - 1; s >= 0; --s)
+        freeSlots.push_back(s);
+
+    auto tag = [](io_uring_sqe *sqe, int s) {
+        io_uring_sqe_set_data(sqe, reinterpret_cast<void *>(quintptr(s)));
+    };
+
+    int inFlight = 0;
+    auto finish = [&](int s) {
+        (*done)[slots[size_t(s)].entry] = true;
+        freeSlots.push_back(s);
+        --inFlight;
+    };
+
+    // A filter or a kernel the probe misjudged can still refuse an opcode.
+    // The entry is then left to the threads, and so is everything not
+    // submitted yet.
+    bool unsupported = false;
+    auto abandon = [&](int s) {
+        Slot &slot = slots[size_t(s)];
+        if (slot.fd >= 0)
+            ::close(slot.fd);
+        resetEntry(&data[slot.entry]);
+        freeSlots.push_back(s);
+        --inFlight;
+        unsupported = true;
+    };
+
+    auto complete = [&](int s, int res) {
+        Slot &slot = slots[size_t(s)];
+        Entry &entry = data[slot.entry];
+        if (res == -EINVAL) {
+            abandon(s);
+            return;
+        }
+        switch (slot.stage) {
+        case StatxStage:
+            if (res < 0) {
+                entry.error = -res;
+                finish(s);
+            } else {
+                entry.mode = slot.stx.stx_mode;
+                if (mHeaderSize == 0 || !S_ISREG(entry.mode)) {
+                    finish(s);
+                } else {
+                    slot.stage = OpenStage;
+                    io_uring_sqe *sqe = io_uring_get_sqe(ring);
+                    io_uring_prep_openat(sqe, AT_FDCWD, entry.path.constData(), O_RDONLY | O_CLOEXEC | O_NOCTTY, 0);
+                    tag(sqe, s);
+                }
+            }
+            break;
+        case OpenStage:
+            if (res < 0) {
+                finish(s); // it exists but can't be read, there's no header
+            } else {
+                slot.fd = res;
+                slot.stage = ReadStage;
+                entry.header.resize(mHeaderSize);
+                io_uring_sqe *sqe = io_uring_get_sqe(ring);
+                io_uring_prep_read(sqe, slot.fd, entry.header.data(), unsigned(mHeaderSize), 0);
+                tag(sqe, s);
+            }
+            break;
+        case ReadStage: {
+            entry.header.resize(res > 0 ? res : 0);
+            slot.stage = CloseStage;
+            io_uring_sqe *sqe = io_uring_get_sqe(ring);
+            io_uring_prep_close(sqe, slot.fd);
+            tag(sqe, s);
+            break;
+        }
+        case CloseStage:
+            slot.fd = -1;
+            finish(s);
+            break;
+        }
+    };
+
+    qsizetype next = 0;
+    bool failed = false;
+    for (;;) {
+        while (!unsupported && next < entries->size() && !freeSlots.empty()) {
+            const int s = freeSlots.back();
+            freeSlots.pop_back();
+            Slot &slot = slots[size_t(s)];
+            slot.entry = next++;
+            slot.stage = StatxStage;
+            slot.fd = -1;
+            io_uring_sqe *sqe = io_uring_get_sqe(ring);
+            io_uring_prep_statx(sqe, AT_FDCWD, data[slot.entry].path.constData(), 0, STATX_TYPE | STATX_MODE,
+                                &slot.stx);
+            tag(sqe, s);
+            ++inFlight;
+        }
+        if (inFlight == 0)
+            break;
+
+        const int ret = io_uring_submit_and_wait(ring, 1);
+        if (ret < 0 && ret != -EINTR && ret != -EAGAIN && ret != -EBUSY) {
+            failed = true;
+            break;
+        }
+
+        unsigned head;
+        unsigned count = 0;
+        io_uring_cqe *cqe;
+        io_uring_for_each_cqe(ring, head, cqe) {
+            ++count;
+            complete(int(quintptr(io_uring_cqe_get_data(cqe))), cqe->res);
+        }
+        io_uring_cq_advance(ring, count);
+    }
+
+    if (!failed && !unsupported)
+        return true;
+
+    if (unsupported) {
+        io_uring_queue_exit(ring);
+        delete mRing;
+        mRing = nullptr;
+        return false;
+    }
+
+    // Collect what the kernel still holds, the threads redo the unfinished
+    // entries, then give up on the ring
+    __kernel_timespec timeout = {1, 0};
+    io_uring_cqe *cqe;
+    while (inFlight > 0 && io_uring_wait_cqe_timeout(ring, &cqe, &timeout) == 0) {
+        const Slot &slot = slots[size_t(quintptr(io_uring_cqe_get_data(cqe)))];
+        if (slot.stage == OpenStage && cqe->res >= 0)
+            ::close(cqe->res);
+        else if (slot.stage == ReadStage)
+            ::close(slot.fd);
+        --inFlight;
+        io_uring_cqe_seen(ring, cqe);
+    }
+    io_uring_queue_exit(ring);
+    delete mRing;
+    mRing = nullptr;
+    return false;
+#else
+    Q_UNUSED(entries);
+    Q_UNUSED(done);
+    return false;
+#endif
+}
+
+void MatFileProbe::runThreads(QList<Entry> *entries, const QList<bool> &done)
+{
+    Entry *const data = entries->data();
+    const qsizetype size = entries->size();
+    std::atomic<qsizetype> next{0};
+    auto work = [&]() {
+        for (qsizetype i = next.fetch_add(1); i < size; i = next.fetch_add(1)) {
+            if (!done.at(i))
+                probeEntry(data + i, mHeaderSize);
+        }
+    };
+
+    if (size <= 1) { // not worth a thread
+        work();
+        return;
+    }
+
+    const int workers = int(qMin<qsizetype>(mQueueDepth, size));
+    for (int w = 0; w < workers; ++w)
+        mPool.start(work);
+    mPool.waitForDone();
+}
@@ -0,0 +1,87 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#ifndef MATFILEPROBE_H
+#define MATFILEPROBE_H
+
+#include <QByteArray>
+#include <QList>
+#include <QThreadPool>
+#include <QtGlobal>
+
+/*!
+ * \brief The MatFileProbe class stats files, and reads their first bytes,
+ * a batch at a time with many I/Os in flight.
+ *
+ * On Linux, with liburing at build time, the statx, open, read and close
+ * operations go through an io_uring of the given queue depth. Otherwise, or
+ * when the kernel refuses the ring or doesn't support those opcodes, as many
+ * threads do blocking calls. The ring is only set up by the first batch of
+ * more than one entry.
+ * QTXDG_MAT_NO_IO_URING forces the threads.
+ */
+class MatFileProbe {
+
+public:
+    struct Entry {
+        QByteArray path;      //!< Set by the caller, NUL terminated
+        int error = 0;        //!< errno of the stat, 0 if it exists
+        quint32 mode = 0;     //!< st_mode
+        QByteArray header;    //!< Of regular files, if a header size was given
+    };
+
+    /*!
+     * \brief MatFileProbe
+     * \param queueDepth The I/Os in flight
+     * \param headerSize The bytes read from the start of regular files, none
+     * if 0
+     */
+    explicit MatFileProbe(int queueDepth = 32, qsizetype headerSize = 0);
+    virtual ~MatFileProbe();
+    Q_DISABLE_COPY_MOVE(MatFileProbe)
+
+    /*!
+     * \brief run Probes every entry, in no particular order
+     * \param entries
+     */
+    void run(QList<Entry> *entries);
+
+    /*!
+     * \brief backend
+     * \return "io_uring" or "threads", for the batches of more than one entry.
+     * Until such a batch is run, "threads".
+     */
+    const char *backend() const;
+
+private:
+    struct Ring;
+
+    void setUpRing();
+    bool runRing(QList<Entry> *entries, QList<bool> *done);
+    void runThreads(QList<Entry> *entries, const QList<bool> &done);
+
+    int mQueueDepth;
+    qsizetype mHeaderSize;
+    Ring *mRing;
+    bool mRingChecked;
+    QThreadPool mPool;
+};
+
+#endif // MATFILEPROBE_H
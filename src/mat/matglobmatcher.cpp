@@ -0,0 +1,305 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "matglobmatcher.h"
+
+#include "xdgdirs.h"
+
+#include <QFile>
+#include <QHash>
+#include <QSet>
+#include <QStringEncoder>
+#include <QVarLengthArray>
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include <fnmatch.h>
+
+using namespace Qt::Literals::StringLiterals;
+
+namespace {
+
+inline char16_t foldCase(char16_t c)
+{
+    if (c < 128)
+        return c >= u'A' && c <= u'Z' ? char16_t(c + 32) : c;
+    return char16_t(QChar::toLower(c));
+}
+
+QString folded(QStringView s)
+{
+    QString result(s.size(), Qt::Uninitialized);
+    std::transform(s.begin(), s.end(), result.begin(), [](QChar c) { return QChar(foldCase(c.unicode())); });
+    return result;
+}
+
+bool hasWildcard(QStringView pattern)
+{
+    return std::any_of(pattern.begin(), pattern.end(), [](QChar c) {
+        return c == u'*' || c == u'?' || c == u'[';
+    });
+}
+
+using NameBuffer = QVarLengthArray<char, 256>;
+
+void encodeName(QStringView name, NameBuffer *buffer)
+{
+    buffer->resize(name.size() * 3 + 1);
+    QStringEncoder encoder(QStringEncoder::Utf8);
+    char *end = encoder.appendToBuffer(buffer->data(), name);
+    *end = '\0';
+}
+
+} // namespace
+
+class MatGlobMatcher::TrieBuilder {
+
+public:
+    TrieBuilder()
+        : mNodes(1)
+    {
+    }
+
+    // Inserts the characters of suffix last to first
+    void insert(QStringView suffix, qsizetype glob)
+    {
+        size_t node = 0;
+        for (qsizetype i = suffix.size(); i-- > 0;) {
+            const char16_t c = suffix.at(i).unicode();
+            const auto it = mNodes[node].children.find(c);
+            if (it != mNodes[node].children.end()) {
+                node = it->second;
+            } else {
+                const size_t child = mNodes.size();
+                mNodes[node].children.emplace(c, child);
+                mNodes.emplace_back();
+                node = child;
+            }
+        }
+        mNodes[node].globs.append(glob);
+    }
+
+    // Flattens the nodes, the edges of each node are sorted by std::map
+    Trie build() const
+    {
+        Trie trie;
+        trie.nodes.reserve(qsizetype(mNodes.size()));
+        for (const BuildNode &buildNode : mNodes) {
+            Node node;
+            node.firstEdge = quint32(trie.edges.size());
+            node.edgeCount = quint32(buildNode.children.size());
+            node.firstGlob = quint32(trie.globs.size());
+            node.globCount = quint32(buildNode.globs.size());
+            for (const auto &[c, child] : buildNode.children)
+                trie.edges.append(Edge{c, quint32(child)});
+            trie.globs.append(buildNode.globs);
+            trie.nodes.append(node);
+        }
+        return trie;
+    }
+
+private:
+    struct BuildNode {
+        std::map<char16_t, size_t> children;
+        QList<qsizetype> globs;
+    };
+
+    std::vector<BuildNode> mNodes;
+};
+
+MatGlobMatcher::MatGlobMatcher() = default;
+
+MatGlobMatcher::~MatGlobMatcher() = default;
+
+bool MatGlobMatcher::load(const QStringList &mimeDirs)
+{
+    mGlobs.clear();
+    mMimeTypes.clear();
+    mComplex.clear();
+
+    TrieBuilder caseSensitive;
+    TrieBuilder caseFolded;
+    QHash<QString, qsizetype> mimeTypeIndex;
+    QSet<QString> seen;
+    QSet<QString> blocked; // by a __NOGLOBS__ of a more important directory
+    bool found = false;
+
+    for (const QString &dir : mimeDirs) {
+        QFile file(dir + "/globs2"_L1);
+        if (!file.open(QIODevice::ReadOnly))
+            continue;
+        found = true;
+
+        QSet<QString> noGlobs;
+        const QList<QByteArray> lines = file.readAll().split('\n');
+        for (const QByteArray &rawLine : lines) {
+            const QByteArray line = rawLine.trimmed();
+            if (line.isEmpty() || line.startsWith('#'))
+                continue;
+
+            // weight:mimetype:pattern[:flags]
+            const QList<QByteArray> fields = line.split(':');
+            bool ok = false;
+            const int weight = fields.size() >= 3 ? fields.at(0).toInt(&ok) : 0;
+            if (!ok)
+                continue;
+
+            const QString mimeType = QString::fromUtf8(fields.at(1));
+            const QString pattern = QString::fromUtf8(fields.at(2));
+            if (pattern == "__NOGLOBS__"_L1) {
+                noGlobs.insert(mimeType);
+                continue;
+            }
+            if (mimeType.isEmpty() || pattern.isEmpty() || blocked.contains(mimeType))
+                continue;
+
+            const bool cs = fields.size() > 3 && fields.at(3).split(',').contains("cs");
+            const QString key = pattern + (cs ? u":cs:"_s : u":"_s) + mimeType;
+            if (seen.contains(key))
+                continue;
+            seen.insert(key);
+
+            auto index = mimeTypeIndex.constFind(mimeType);
+            if (index == mimeTypeIndex.constEnd()) {
+                index = mimeTypeIndex.insert(mimeType, mMimeTypes.size());
+                mMimeTypes.append(mimeType);
+            }
+
+            const QString text = cs ? pattern : folded(pattern);
+            const bool literal = !hasWildcard(text);
+            const bool suffix = !literal && text.size() > 1 && text.front() == u'*'
+                    && !hasWildcard(QStringView(text).sliced(1));
+
+            const qsizetype glob = mGlobs.size();
+            mGlobs.append(Glob{weight, int(pattern.size()), *index, literal, cs});
+
+            if (literal || suffix) {
+                TrieBuilder &builder = cs ? caseSensitive : caseFolded;
+                builder.insert(literal ? QStringView(text) : QStringView(text).sliced(1), glob);
+            } else {
+                mComplex.append(Complex{text.toUtf8(), glob, cs});
+            }
+        }
+        blocked.unite(noGlobs);
+    }
+
+    mCaseSensitive = caseSensitive.build();
+    mCaseFolded = caseFolded.build();
+    return found;
+}
+
+bool MatGlobMatcher::isEmpty() const
+{
+    return mGlobs.isEmpty();
+}
+
+QStringView MatGlobMatcher::match(QStringView fileName) const
+{
+    const QStringView name = fileName.sliced(fileName.lastIndexOf(u'/') + 1);
+    if (name.isEmpty())
+        return QStringView();
+
+    qsizetype best = -1;
+    matchTrie(mCaseSensitive, name, false, &best);
+    matchTrie(mCaseFolded, name, true, &best);
+
+    NameBuffer exact;
+    NameBuffer foldedName;
+    for (const Complex &complex : mComplex) {
+        if (!beats(complex.glob, best))
+            continue;
+
+        NameBuffer &buffer = complex.caseSensitive ? exact : foldedName;
+        if (buffer.isEmpty()) { // encoded on first use only
+            if (complex.caseSensitive) {
+                encodeName(name, &buffer);
+            } else {
+                QVarLengthArray<char16_t, 256> lower(name.size());
+                std::transform(name.begin(), name.end(), lower.begin(), [](QChar c) { return foldCase(c.unicode()); });
+                encodeName(QStringView(lower.constData(), lower.size()), &buffer);
+            }
+        }
+        if (::fnmatch(complex.pattern.constData(), buffer.constData(), 0) == 0)
+            best = complex.glob;
+    }
+
+    if (best < 0)
+        return QStringView();
+    return mMimeTypes.at(mGlobs.at(best).mimeType);
+}
+
+void MatGlobMatcher::matchTrie(const Trie &trie, QStringView name, bool fold, qsizetype *best) const
+{
+    if (trie.nodes.isEmpty())
+        return;
+
+    const Edge *const edges = trie.edges.constData();
+    quint32 node = 0;
+    for (qsizetype i = name.size(); i-- > 0;) {
+        const char16_t c = fold ? foldCase(name.at(i).unicode()) : name.at(i).unicode();
+        const Node &parent = trie.nodes.at(node);
+        const Edge *begin = edges + parent.firstEdge;
+        const Edge *end = begin + parent.edgeCount;
+        const Edge *edge = std::lower_bound(begin, end, c, [](const Edge &e, char16_t value) {
+            return e.c < value;
+        });
+        if (edge == end || edge->c != c)
+            return;
+
+        node = edge->node;
+        const Node &current = trie.nodes.at(node);
+        for (quint32 g = current.firstGlob; g < current.firstGlob + current.globCount; ++g) {
+            const qsizetype glob = trie.globs.at(g);
+            if (mGlobs.at(glob).anchored && i != 0)
+                continue;
+            if (beats(glob, *best))
+                *best = glob;
+        }
+    }
+}
+
+bool MatGlobMatcher::beats(qsizetype glob, qsizetype best) const
+{
+    if (best < 0)
+        return true;
+    const Glob &a = mGlobs.at(glob);
+    const Glob &b = mGlobs.at(best);
+    if (a.weight != b.weight)
+        return a.weight > b.weight;
+    if (a.length != b.length)
+        return a.length > b.length;
+    // The exact case is more specific, *.C:cs beats *.c on "main.C"
+    if (a.caseSensitive != b.caseSensitive)
+        return a.caseSensitive;
+    return glob < best;
+}
+
+QStringList MatGlobMatcher::mimeDirs()
+{
+    QStringList dirs;
+    dirs.append(XdgDirs::dataHome(false) + "/mime"_L1);
+    const QStringList dataDirs = XdgDirs::dataDirs();
+    for (const QString &dir : dataDirs)
+        dirs.append(dir + "/mime"_L1);
+    dirs.removeDuplicates();
+    return dirs;
+}
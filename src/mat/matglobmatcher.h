@@ -0,0 +1,123 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#ifndef MATGLOBMATCHER_H
+#define MATGLOBMATCHER_H
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QStringView>
+
+/*!
+ * \brief The MatGlobMatcher class classifies file names with the
+ * shared-mime-info globs2 files, compiled once for many lookups.
+ *
+ * Literal and "*.ext" like patterns go into two reversed tries, one for the
+ * case sensitive patterns and one for the case folded others. A file name is
+ * walked once per trie from its end, no copy of it is made. A literal is a
+ * suffix that must span the whole name. The remaining patterns are matched
+ * with fnmatch(), and only when they could beat what the tries found.
+ *
+ * Like in the spec, the highest weight wins, then the longest pattern, then
+ * a case sensitive pattern. An exact tie goes to the first pattern, in
+ * XDG_DATA_DIRS precedence.
+ * __NOGLOBS__ drops the patterns of less important directories.
+ */
+class MatGlobMatcher {
+
+public:
+    MatGlobMatcher();
+    virtual ~MatGlobMatcher();
+
+    /*!
+     * \brief load Compiles the globs2 files
+     * \param mimeDirs The mime directories, most important first
+     * \return false if there's no globs2 file in any of them
+     */
+    bool load(const QStringList &mimeDirs = mimeDirs());
+
+    /*!
+     * \brief isEmpty
+     * \return true if no pattern was loaded
+     */
+    bool isEmpty() const;
+
+    /*!
+     * \brief match
+     * \param fileName A file name, the leading directories are ignored
+     * \return The mimetype of the best pattern matching \a fileName or an
+     * empty view
+     */
+    QStringView match(QStringView fileName) const;
+
+    /*!
+     * \brief mimeDirs
+     * \return The mime directories of the environment, most important first
+     */
+    static QStringList mimeDirs();
+
+private:
+    struct Glob {
+        int weight;
+        int length; //!< Of the whole pattern
+        qsizetype mimeType; //!< Index in mMimeTypes
+        bool anchored; //!< A literal, the suffix must be the whole name
+        bool caseSensitive;
+    };
+
+    struct Complex {
+        QByteArray pattern; //!< UTF-8, case folded unless caseSensitive
+        qsizetype glob;
+        bool caseSensitive;
+    };
+
+    struct Edge {
+        char16_t c;
+        quint32 node;
+    };
+
+    struct Node {
+        quint32 firstEdge;
+        quint32 edgeCount;
+        quint32 firstGlob;
+        quint32 globCount;
+    };
+
+    struct Trie {
+        QList<Node> nodes;
+        QList<Edge> edges;
+        QList<qsizetype> globs;
+    };
+
+    class TrieBuilder;
+
+    void matchTrie(const Trie &trie, QStringView name, bool fold, qsizetype *best) const;
+    bool beats(qsizetype glob, qsizetype best) const;
+
+    QList<Glob> mGlobs;
+    QStringList mMimeTypes;
+    Trie mCaseSensitive;
+    Trie mCaseFolded;
+    QList<Complex> mComplex;
+};
+
+#endif // MATGLOBMATCHER_H
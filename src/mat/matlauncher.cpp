@@ -0,0 +1,349 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "matlauncher.h"
+
+#include <QByteArray>
+#include <QFile>
+
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace Qt::Literals::StringLiterals;
+
+// Well above ARG_MAX, anything bigger is a protocol error
+static constexpr uint32_t MaxMessageSize = 16 * 1024 * 1024;
+
+// The arguments and environment entries of a launch, together
+static constexpr size_t MaxEntries = 256 * 1024;
+
+static bool readFully(int fd, void *data, size_t size)
+{
+    char *p = static_cast<char *>(data);
+    while (size > 0) {
+        const ssize_t len = ::recv(fd, p, size, 0);
+        if (len < 0 && errno == EINTR)
+            continue;
+        if (len <= 0)
+            return false;
+        p += len;
+        size -= size_t(len);
+    }
+    return true;
+}
+
+static bool writeFully(int fd, const void *data, size_t size)
+{
+    const char *p = static_cast<const char *>(data);
+    while (size > 0) {
+        const ssize_t len = ::send(fd, p, size, MSG_NOSIGNAL);
+        if (len < 0 && errno == EINTR)
+            continue;
+        if (len <= 0)
+            return false;
+        p += len;
+        size -= size_t(len);
+    }
+    return true;
+}
+
+/*
+ * Helper side. The caller may have had threads when it forked, e.g. a lock
+ * of malloc() held by one of them stays held in the helper. So from here on
+ * only async-signal-safe calls, into the buffers mapped before the fork, and
+ * the helper never returns to Qt.
+ */
+
+// strtoul() isn't async-signal-safe, it may look at the locale
+static bool parseCount(const char *s, size_t *count)
+{
+    size_t n = 0;
+    if (*s == '\0')
+        return false;
+    for (; *s != '\0'; ++s) {
+        if (*s < '0' || *s > '9' || n > MaxEntries)
+            return false;
+        n = n * 10 + size_t(*s - '0');
+    }
+    *count = n;
+    return true;
+}
+
+// execvp() isn't async-signal-safe. The PATH of the launched environment is
+// searched, as execvp() does once environ is replaced, with the glibc
+// default path when it's unset. Unlike execvp(), a file without a known
+// executable format isn't run through /bin/sh.
+static void execPath(char **argv, char **envp)
+{
+    const char *file = argv[0];
+    if (strchr(file, '/') != nullptr) {
+        ::execve(file, argv, envp);
+        return;
+    }
+
+    const char *path = "/bin:/usr/bin";
+    for (char **env = envp; *env != nullptr; ++env) {
+        if (strncmp(*env, "PATH=", 5) == 0) {
+            path = *env + 5;
+            break;
+        }
+    }
+
+    const size_t fileSize = strlen(file);
+    char buffer[PATH_MAX];
+    bool denied = false;
+    for (const char *dir = path;; ++dir) {
+        const char *end = strchr(dir, ':');
+        if (end == nullptr)
+            end = dir + strlen(dir);
+        const size_t dirSize = size_t(end - dir);
+        if (dirSize + 1 + fileSize < sizeof(buffer)) {
+            size_t size = 0;
+            if (dirSize == 0) { // an empty entry is the working directory
+                buffer[size++] = '.';
+            } else {
+                memcpy(buffer, dir, dirSize);
+                size = dirSize;
+            }
+            buffer[size++] = '/';
+            memcpy(buffer + size, file, fileSize + 1);
+            ::execve(buffer, argv, envp);
+            if (errno == EACCES)
+                denied = true;
+            else if (errno != ENOENT && errno != ENOTDIR)
+                return;
+        }
+        if (*end == '\0')
+            break;
+        dir = end;
+    }
+    errno = denied ? EACCES : ENOENT;
+}
+
+static int spawn(const char *workingDirectory, char **argv, char **envp)
+{
+    int errorPipe[2];
+    if (::pipe2(errorPipe, O_CLOEXEC) != 0)
+        return errno;
+
+    const pid_t pid = ::fork();
+    if (pid < 0) {
+        const int error = errno;
+        ::close(errorPipe[0]);
+        ::close(errorPipe[1]);
+        return error;
+    }
+
+    if (pid == 0) {
+        ::close(errorPipe[0]);
+        ::setsid();
+        const pid_t grandchild = ::fork();
+        if (grandchild != 0)
+            ::_exit(grandchild < 0 ? 1 : 0);
+
+        if (workingDirectory[0] != '\0' && ::chdir(workingDirectory) != 0) {
+            // run anyway, like QProcess::startDetached() would not
+        }
+        execPath(argv, envp);
+        const int error = errno;
+        ssize_t ignored = ::write(errorPipe[1], &error, sizeof(error));
+        Q_UNUSED(ignored);
+        ::_exit(127);
+    }
+
+    ::close(errorPipe[1]);
+    int status = 0;
+    while (::waitpid(pid, &status, 0) < 0 && errno == EINTR) {}
+
+    // EOF means the execve succeeded, the pipe was closed on exec
+    int error = 0;
+    ssize_t len;
+    do {
+        len = ::read(errorPipe[0], &error, sizeof(error));
+    } while (len < 0 && errno == EINTR);
+    ::close(errorPipe[0]);
+
+    if (len == sizeof(error))
+        return error;
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0 ? 0 : ECHILD;
+}
+
+[[noreturn]] static void helperMain(int fd, char *message, char **pointers)
+{
+    // Don't hold the caller's stdin/stdout (e.g. a coprocess pipe) open
+    const int devNull = ::open("/dev/null", O_RDWR);
+    if (devNull >= 0) {
+        ::dup2(devNull, STDIN_FILENO);
+        ::dup2(devNull, STDOUT_FILENO);
+        if (devNull > STDERR_FILENO)
+            ::close(devNull);
+    }
+
+    for (;;) {
+        uint32_t size = 0;
+        if (!readFully(fd, &size, sizeof(size)) || size == 0 || size > MaxMessageSize)
+            ::_exit(0);
+
+        if (!readFully(fd, message, size) || message[size - 1] != '\0')
+            ::_exit(1);
+
+        // working dir, argc, argv..., environment... The environment goes
+        // one slot further, after the NULL ending the arguments.
+        int32_t result = EINVAL;
+        const char *workingDirectory = message;
+        char *p = message + strlen(message) + 1;
+        size_t argc = 0;
+        if (p < message + size && parseCount(p, &argc) && argc > 0) {
+            p += strlen(p) + 1;
+            size_t count = 0;
+            bool tooMany = false;
+            for (; p < message + size; p += strlen(p) + 1) {
+                if (count == MaxEntries) {
+                    tooMany = true;
+                    break;
+                }
+                pointers[count + (count < argc ? 0 : 1)] = p;
+                ++count;
+            }
+            if (tooMany) {
+                result = E2BIG;
+            } else if (argc <= count) {
+                pointers[argc] = nullptr;
+                pointers[count + 1] = nullptr;
+                result = spawn(workingDirectory, pointers, pointers + argc + 1);
+            }
+        }
+
+        if (!writeFully(fd, &result, sizeof(result)))
+            ::_exit(0);
+    }
+}
+
+MatLauncher::MatLauncher()
+    : mFd(-1),
+      mPid(-1)
+{
+}
+
+MatLauncher::~MatLauncher()
+{
+    stop();
+}
+
+bool MatLauncher::start()
+{
+    if (isRunning())
+        return true;
+
+    // The helper's buffers. Only the pages a launch touches get memory, in
+    // the helper, the mapping is dropped here after the fork.
+    const size_t messageSize = MaxMessageSize;
+    const size_t pointersSize = (MaxEntries + 2) * sizeof(char *);
+    void *buffers = ::mmap(nullptr, messageSize + pointersSize, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (buffers == MAP_FAILED)
+        return false;
+
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) != 0) {
+        ::munmap(buffers, messageSize + pointersSize);
+        return false;
+    }
+
+    const pid_t pid = ::fork();
+    if (pid == 0) {
+        ::close(fds[0]);
+        char *message = static_cast<char *>(buffers);
+        helperMain(fds[1], message, reinterpret_cast<char **>(message + messageSize));
+    }
+
+    ::munmap(buffers, messageSize + pointersSize);
+    if (pid < 0) {
+        ::close(fds[0]);
+        ::close(fds[1]);
+        return false;
+    }
+
+    ::close(fds[1]);
+    mFd = fds[0];
+    mPid = pid;
+    return true;
+}
+
+bool MatLauncher::launch(const QStringList &argv, const QStringList &environment,
+                         const QString &workingDirectory, QString *errorMessage)
+{
+    if (!isRunning()) {
+        *errorMessage = u"Launcher helper not running"_s;
+        return false;
+    }
+    if (argv.isEmpty() || argv.constFirst().isEmpty()) {
+        *errorMessage = u"Empty command"_s;
+        return false;
+    }
+
+    QByteArray message;
+    message.append(QFile::encodeName(workingDirectory)).append('\0');
+    message.append(QByteArray::number(argv.size())).append('\0');
+    for (const QString &arg : argv)
+        message.append(arg.toLocal8Bit()).append('\0');
+    for (const QString &entry : environment)
+        message.append(entry.toLocal8Bit()).append('\0');
+
+    if (message.size() > qsizetype(MaxMessageSize) || size_t(argv.size() + environment.size()) > MaxEntries) {
+        *errorMessage = u"Command line too long"_s;
+        return false;
+    }
+
+    const uint32_t size = uint32_t(message.size());
+    int32_t result = 0;
+    if (!writeFully(mFd, &size, sizeof(size)) || !writeFully(mFd, message.constData(), size)
+            || !readFully(mFd, &result, sizeof(result))) {
+        *errorMessage = u"Launcher helper died"_s;
+        stop();
+        return false;
+    }
+
+    if (result != 0) {
+        *errorMessage = u"Could not run '%1': %2"_s.arg(argv.constFirst(), QString::fromLocal8Bit(strerror(result)));
+        return false;
+    }
+    return true;
+}
+
+void MatLauncher::stop()
+{
+    if (mFd >= 0) {
+        ::close(mFd);
+        mFd = -1;
+    }
+    if (mPid > 0) {
+        while (::waitpid(mPid, nullptr, 0) < 0 && errno == EINTR) {}
+        mPid = -1;
+    }
+}
@@ -0,0 +1,84 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#ifndef MATLAUNCHER_H
+#define MATLAUNCHER_H
+
+#include <QString>
+#include <QStringList>
+
+#include <sys/types.h>
+
+/*!
+ * \brief The MatLauncher class runs commands through a pre-forked helper.
+ *
+ * The helper is forked by start(), before the caller loads anything big,
+ * and talks to the caller over a socketpair. It gets the argv, environment
+ * and working directory of each launch and does the fork and execve itself,
+ * so the large resolver process never forks and its page tables are never
+ * copied. The helper is Qt free and exits when the caller goes away.
+ *
+ * The caller may already have threads, so the helper only makes
+ * async-signal-safe calls, into buffers mapped by start() before the fork.
+ */
+class MatLauncher {
+
+public:
+    /*!
+     * \brief MatLauncher
+     */
+    MatLauncher();
+
+    /*!
+     * \brief ~MatLauncher Stops the helper
+     */
+    virtual ~MatLauncher();
+
+    /*!
+     * \brief start Forks the helper
+     * \return false if the helper couldn't be started
+     */
+    bool start();
+
+    /*!
+     * \brief isRunning
+     * \return
+     */
+    inline bool isRunning() const { return mFd >= 0; }
+
+    /*!
+     * \brief launch Runs a detached command
+     * \param argv The command and its arguments, looked up in PATH
+     * \param environment KEY=VALUE entries
+     * \param workingDirectory Empty to keep the helper one
+     * \param errorMessage
+     * \return true once the command has been executed
+     */
+    bool launch(const QStringList &argv, const QStringList &environment,
+                const QString &workingDirectory, QString *errorMessage);
+
+private:
+    void stop();
+
+    int mFd;
+    pid_t mPid;
+};
+
+#endif // MATLAUNCHER_H
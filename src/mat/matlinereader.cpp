@@ -0,0 +1,90 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "matlinereader.h"
+
+#include <cstring>
+
+static constexpr qsizetype BlockSize = 64 * 1024;
+
+MatLineReader::MatLineReader(FILE *stream, char delimiter)
+    : mStream(stream),
+      mDelimiter(delimiter),
+      mBuffer(BlockSize, Qt::Uninitialized),
+      mPos(0),
+      mEnd(0),
+      mEof(false),
+      mError(false),
+      mDecoder(QStringDecoder::Utf8)
+{
+}
+
+MatLineReader::~MatLineReader() = default;
+
+bool MatLineReader::next(QString *record)
+{
+    for (;;) {
+        char *data = mBuffer.data();
+        const void *delimiter = std::memchr(data + mPos, mDelimiter, size_t(mEnd - mPos));
+        if (delimiter != nullptr) {
+            const qsizetype end = static_cast<const char *>(delimiter) - data;
+            decode(data + mPos, end - mPos, record);
+            mPos = end + 1;
+            return true;
+        }
+
+        if (mEof) {
+            if (mPos == mEnd)
+                return false;
+            decode(data + mPos, mEnd - mPos, record); // no trailing delimiter
+            mPos = mEnd;
+            return true;
+        }
+
+        // Keep the partial record, the buffer only grows for huge ones
+        const qsizetype pending = mEnd - mPos;
+        if (mPos > 0) {
+            std::memmove(data, data + mPos, size_t(pending));
+            mPos = 0;
+            mEnd = pending;
+        }
+        if (mEnd == mBuffer.size())
+            mBuffer.resize(mBuffer.size() * 2);
+
+        const size_t read = std::fread(mBuffer.data() + mEnd, 1, size_t(mBuffer.size() - mEnd), mStream);
+        if (read == 0) {
+            mEof = true;
+            mError = std::ferror(mStream) != 0;
+        }
+        mEnd += qsizetype(read);
+    }
+}
+
+void MatLineReader::decode(const char *data, qsizetype size, QString *record)
+{
+    if (mDelimiter == '\n' && size > 0 && data[size - 1] == '\r')
+        --size;
+
+    // UTF-8 never takes fewer bytes than UTF-16 takes code units
+    record->resize(size);
+    mDecoder.resetState();
+    const QChar *end = mDecoder.appendToBuffer(record->data(), QByteArrayView(data, size));
+    record->truncate(end - record->constData());
+}
@@ -0,0 +1,74 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#ifndef MATLINEREADER_H
+#define MATLINEREADER_H
+
+#include <QByteArray>
+#include <QString>
+#include <QStringDecoder>
+
+#include <cstdio>
+
+/*!
+ * \brief The MatLineReader class splits a stream in records, for the
+ * commands taking their input from the standard input.
+ *
+ * The stream is read in large blocks and each record is decoded into the
+ * caller's string, so a long input costs no allocation per record.
+ */
+class MatLineReader {
+
+public:
+    /*!
+     * \brief MatLineReader
+     * \param stream
+     * \param delimiter '\n' for lines, a trailing '\r' is dropped, or '\0'
+     */
+    explicit MatLineReader(FILE *stream = stdin, char delimiter = '\n');
+    virtual ~MatLineReader();
+
+    /*!
+     * \brief next Reads the next record
+     * \param record Its capacity is reused
+     * \return false at the end of the stream
+     */
+    bool next(QString *record);
+
+    /*!
+     * \brief hasError
+     * \return true if reading the stream failed
+     */
+    inline bool hasError() const { return mError; }
+
+private:
+    void decode(const char *data, qsizetype size, QString *record);
+
+    FILE *mStream;
+    char mDelimiter;
+    QByteArray mBuffer;
+    qsizetype mPos;
+    qsizetype mEnd;
+    bool mEof;
+    bool mError;
+    QStringDecoder mDecoder;
+};
+
+#endif // MATLINEREADER_H
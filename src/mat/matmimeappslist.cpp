@@ -0,0 +1,252 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "matmimeappslist.h"
+
+#include "xdgdirs.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace Qt::Literals::StringLiterals;
+
+// Larger files aren't read, they would only make the reader, e.g. a server
+// shared by all users, run out of memory
+static constexpr qint64 MaxFileSize = 4 * 1024 * 1024;
+
+MatMimeAppsList::MatMimeAppsList(const QString &fileName)
+    : mFileName(fileName)
+{
+}
+
+bool MatMimeAppsList::load()
+{
+    for (auto &group : mGroups)
+        group.clear();
+
+    QFile file(mFileName);
+    if (!file.exists())
+        return true;
+
+    if (mOwner < 0) {
+        if (!file.open(QIODevice::ReadOnly))
+            return false;
+    } else {
+        // Checked on the opened file, it can't be swapped after the check.
+        // O_NONBLOCK keeps a FIFO from blocking the reader.
+        const int fd = ::open(QFile::encodeName(mFileName).constData(), O_RDONLY | O_CLOEXEC | O_NOCTTY | O_NONBLOCK);
+        if (fd < 0)
+            return false;
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || qint64(st.st_uid) != mOwner || st.st_size > MaxFileSize
+                || !file.open(fd, QIODevice::ReadOnly, QFileDevice::AutoCloseHandle)) {
+            ::close(fd);
+            return false;
+        }
+    }
+
+    // At most one byte more than allowed, to tell a file grown since
+    const QByteArray data = file.read(MaxFileSize + 1);
+    if (data.size() > MaxFileSize)
+        return false;
+    parse(data);
+    return true;
+}
+
+void MatMimeAppsList::parse(QByteArrayView data)
+{
+    for (auto &group : mGroups)
+        group.clear();
+
+    QHash<QString, QStringList> *group = nullptr;
+    qsizetype begin = 0;
+    while (begin < data.size()) {
+        qsizetype end = data.indexOf('\n', begin);
+        if (end < 0)
+            end = data.size();
+        const QByteArrayView line = data.sliced(begin, end - begin).trimmed();
+        begin = end + 1;
+
+        if (line.isEmpty() || line.startsWith('#'))
+            continue;
+
+        if (line.startsWith('[')) {
+            if (line == "[Default Applications]")
+                group = &mGroups[DefaultApplications];
+            else if (line == "[Added Associations]")
+                group = &mGroups[AddedAssociations];
+            else if (line == "[Removed Associations]")
+                group = &mGroups[RemovedAssociations];
+            else
+                group = nullptr;
+            continue;
+        }
+
+        const qsizetype eq = line.indexOf('=');
+        if (group == nullptr || eq <= 0)
+            continue;
+
+        const QString mimeType = QString::fromUtf8(line.first(eq).trimmed());
+        const QStringList ids = QString::fromUtf8(line.sliced(eq + 1).trimmed()).split(u';', Qt::SkipEmptyParts);
+        QStringList &apps = (*group)[mimeType];
+        for (const QString &id : ids) {
+            const QString trimmed = id.trimmed();
+            if (!trimmed.isEmpty() && !apps.contains(trimmed))
+                apps.append(trimmed);
+        }
+    }
+}
+
+QStringList MatMimeAppsList::apps(Group group, const QString &mimeType) const
+{
+    return mGroups[group].value(mimeType);
+}
+
+bool MatMimeAppsList::isEmpty() const
+{
+    for (const auto &group : mGroups) {
+        if (!group.isEmpty())
+            return false;
+    }
+    return true;
+}
+
+QLatin1StringView MatMimeAppsList::groupName(Group group)
+{
+    switch (group) {
+    case DefaultApplications:
+        return "Default Applications"_L1;
+    case AddedAssociations:
+        return "Added Associations"_L1;
+    case RemovedAssociations:
+        return "Removed Associations"_L1;
+    }
+    return QLatin1StringView();
+}
+
+MatMimeAppsLayers::MatMimeAppsLayers()
+    : MatMimeAppsLayers(defaultFileNames())
+{
+}
+
+MatMimeAppsLayers::MatMimeAppsLayers(const QStringList &fileNames)
+{
+    mLayers.reserve(fileNames.size());
+    for (const QString &fileName : fileNames) {
+        Layer layer;
+        layer.list = MatMimeAppsList(fileName);
+        mLayers.append(layer);
+    }
+}
+
+void MatMimeAppsLayers::setOwner(qint64 uid)
+{
+    for (Layer &layer : mLayers) {
+        layer.list.setOwner(uid);
+        layer.loaded = false;
+    }
+}
+
+QList<const MatMimeAppsList *> MatMimeAppsLayers::layers()
+{
+    QList<const MatMimeAppsList *> list;
+    list.reserve(mLayers.size());
+    for (Layer &layer : mLayers) {
+        if (!layer.loaded) {
+            layer.mtime = modificationTime(layer.list.fileName());
+            layer.list.load();
+            layer.loaded = true;
+        }
+        list.append(&layer.list);
+    }
+    return list;
+}
+
+QStringList MatMimeAppsLayers::fileNames() const
+{
+    QStringList list;
+    for (const Layer &layer : mLayers)
+        list.append(layer.list.fileName());
+    return list;
+}
+
+bool MatMimeAppsLayers::invalidate(const QString &fileName)
+{
+    bool found = false;
+    for (Layer &layer : mLayers) {
+        if (layer.list.fileName() == fileName) {
+            layer.loaded = false;
+            found = true;
+        }
+    }
+    return found;
+}
+
+void MatMimeAppsLayers::refresh()
+{
+    for (Layer &layer : mLayers) {
+        if (layer.loaded && modificationTime(layer.list.fileName()) != layer.mtime)
+            layer.loaded = false;
+    }
+}
+
+qint64 MatMimeAppsLayers::modificationTime(const QString &fileName)
+{
+    const QFileInfo info(fileName);
+    if (!info.exists())
+        return -1;
+    return info.lastModified().toMSecsSinceEpoch();
+}
+
+QStringList MatMimeAppsLayers::defaultFileNames()
+{
+    QStringList dirs;
+    dirs.append(XdgDirs::configHome(false));
+    dirs.append(XdgDirs::configDirs());
+    dirs.append(XdgDirs::dataHome(false) + "/applications"_L1);
+    const QStringList dataDirs = XdgDirs::dataDirs();
+    for (const QString &dir : dataDirs)
+        dirs.append(dir + "/applications"_L1);
+
+    return layerFileNames(dirs, currentDesktops());
+}
+
+QStringList MatMimeAppsLayers::layerFileNames(const QStringList &dirs, const QStringList &desktops)
+{
+    QStringList files;
+    for (const QString &dir : dirs) {
+        for (const QString &desktop : desktops)
+            files.append(dir + u'/' + desktop + "-mimeapps.list"_L1);
+        files.append(dir + "/mimeapps.list"_L1);
+    }
+    files.removeDuplicates();
+    return files;
+}
+
+QStringList MatMimeAppsLayers::currentDesktops()
+{
+    const QString env = qEnvironmentVariable("XDG_CURRENT_DESKTOP");
+    return env.toLower().split(u':', Qt::SkipEmptyParts);
+}
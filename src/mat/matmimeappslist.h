@@ -0,0 +1,198 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#ifndef MATMIMEAPPSLIST_H
+#define MATMIMEAPPSLIST_H
+
+#include <QByteArrayView>
+#include <QHash>
+#include <QLatin1StringView>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+/*!
+ * \brief The MatMimeAppsList class is one parsed mimeapps.list layer.
+ */
+class MatMimeAppsList {
+
+public:
+    enum Group {
+        DefaultApplications,
+        AddedAssociations,
+        RemovedAssociations
+    };
+
+    /*!
+     * \brief MatMimeAppsList
+     * \param fileName
+     */
+    explicit MatMimeAppsList(const QString &fileName = QString());
+
+    /*!
+     * \brief fileName
+     * \return
+     */
+    inline QString fileName() const { return mFileName; }
+
+    /*!
+     * \brief setOwner Only reads the file if \a uid owns it
+     *
+     * For reading a layer on another user's behalf: the file, once symbolic
+     * links are followed, must be a regular file of that user's, so it can't
+     * point to one only the reader may read. A file that isn't is an empty
+     * layer.
+     * \param uid The owner, -1 accepts any
+     */
+    inline void setOwner(qint64 uid) { mOwner = uid; }
+
+    /*!
+     * \brief load (Re)reads the file. A missing file is an empty layer.
+     * \return false if the file exists but can't be read or is larger than
+     * 4 MiB
+     */
+    bool load();
+
+    /*!
+     * \brief parse Replaces the contents with the ones of \a data
+     * \param data The contents of a mimeapps.list
+     */
+    void parse(QByteArrayView data);
+
+    /*!
+     * \brief apps
+     * \param group
+     * \param mimeType
+     * \return The desktop ids listed for \a mimeType in \a group
+     */
+    QStringList apps(Group group, const QString &mimeType) const;
+
+    /*!
+     * \brief entries
+     * \param group
+     * \return The whole \a group, mimetype to desktop ids
+     */
+    inline const QHash<QString, QStringList> &entries(Group group) const { return mGroups[group]; }
+
+    /*!
+     * \brief isEmpty
+     * \return true if no group has entries
+     */
+    bool isEmpty() const;
+
+    /*!
+     * \brief groupName
+     * \param group
+     * \return The group name as written in the file, without the brackets
+     */
+    static QLatin1StringView groupName(Group group);
+
+private:
+    QString mFileName;
+    qint64 mOwner = -1;
+    QHash<QString, QStringList> mGroups[3];
+};
+
+/*!
+ * \brief The MatMimeAppsLayers class is the ordered stack of mimeapps.list
+ * files, as defined by the MIME Applications Associations spec.
+ *
+ * Layers are read on first use and can be invalidated one by one.
+ */
+class MatMimeAppsLayers {
+
+public:
+    /*!
+     * \brief MatMimeAppsLayers Uses the layers of the current environment
+     */
+    MatMimeAppsLayers();
+
+    /*!
+     * \brief MatMimeAppsLayers
+     * \param fileNames The layer files, most important first
+     */
+    explicit MatMimeAppsLayers(const QStringList &fileNames);
+
+    /*!
+     * \brief setOwner Sets the owner every layer file must have
+     * \param uid The owner, -1 accepts any
+     * \sa MatMimeAppsList::setOwner()
+     */
+    void setOwner(qint64 uid);
+
+    /*!
+     * \brief layers
+     * \return The loaded layers, most important first
+     */
+    QList<const MatMimeAppsList *> layers();
+
+    /*!
+     * \brief fileNames
+     * \return The layer files, most important first
+     */
+    QStringList fileNames() const;
+
+    /*!
+     * \brief invalidate Drops the cached contents of one layer
+     * \param fileName
+     * \return false if \a fileName isn't one of the layers
+     */
+    bool invalidate(const QString &fileName);
+
+    /*!
+     * \brief refresh Drops the layers whose file changed since it was read
+     *
+     * Costs one stat per layer. Meant for callers without a MatWatcher.
+     */
+    void refresh();
+
+    /*!
+     * \brief defaultFileNames
+     * \return The layer files of the current environment
+     */
+    static QStringList defaultFileNames();
+
+    /*!
+     * \brief layerFileNames
+     * \param dirs The directories holding layers, most important first
+     * \param desktops The current desktops, see currentDesktops()
+     * \return The desktop specific and generic mimeapps.list of every dir
+     */
+    static QStringList layerFileNames(const QStringList &dirs, const QStringList &desktops);
+
+    /*!
+     * \brief currentDesktops
+     * \return The lowercased XDG_CURRENT_DESKTOP entries
+     */
+    static QStringList currentDesktops();
+
+private:
+    struct Layer {
+        MatMimeAppsList list;
+        bool loaded = false;
+        qint64 mtime = -1; //!< -1 if the file doesn't exist
+    };
+
+    static qint64 modificationTime(const QString &fileName);
+
+    QList<Layer> mLayers;
+};
+
+#endif // MATMIMEAPPSLIST_H
@@ -0,0 +1,292 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "matmimeappswriter.h"
+
+#include "xdgdirs.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QSet>
+
+#include <algorithm>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/file.h>
+#include <unistd.h>
+
+using namespace Qt::Literals::StringLiterals;
+
+static QByteArray entryLine(const QString &mimeType, const QStringList &ids)
+{
+    return mimeType.toUtf8() + '=' + ids.join(u';').toUtf8() + ';';
+}
+
+static int groupOfHeader(QByteArrayView line)
+{
+    for (int group = MatMimeAppsList::DefaultApplications; group <= MatMimeAppsList::RemovedAssociations; ++group) {
+        const QLatin1StringView name = MatMimeAppsList::groupName(static_cast<MatMimeAppsList::Group>(group));
+        if (line.size() == name.size() + 2 && line.sliced(1, name.size()) == QByteArrayView(name.data(), name.size()))
+            return group;
+    }
+    return -1;
+}
+
+MatMimeAppsWriter::MatMimeAppsWriter(const QString &fileName)
+    : mFileName(fileName),
+      mLockFd(-1)
+{
+}
+
+MatMimeAppsWriter::~MatMimeAppsWriter()
+{
+    unlock();
+}
+
+void MatMimeAppsWriter::setDefaultApp(const QString &mimeType, const QString &id)
+{
+    mChanges.append(Change{true, MatMimeAppsList::DefaultApplications, mimeType, QStringList{id}});
+}
+
+void MatMimeAppsWriter::setApps(MatMimeAppsList::Group group, const QString &mimeType, const QStringList &ids)
+{
+    QStringList unique = ids;
+    unique.removeDuplicates();
+    mChanges.append(Change{false, group, mimeType, unique});
+}
+
+bool MatMimeAppsWriter::lock(QString *errorMessage)
+{
+    if (mLockFd >= 0)
+        return true;
+
+    auto fail = [errorMessage](const QString &message) {
+        if (errorMessage != nullptr)
+            *errorMessage = message;
+        return false;
+    };
+
+    const QFileInfo info(mFileName);
+    if (!QDir().mkpath(info.absolutePath()))
+        return fail(u"Could not create %1"_s.arg(info.absolutePath()));
+
+    // Not the list itself, QSaveFile replaces its inode
+    const QByteArray lockFileName = QFile::encodeName(info.absolutePath() + "/."_L1 + info.fileName() + ".lock"_L1);
+    const int lockFd = ::open(lockFileName.constData(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (lockFd < 0)
+        return fail(u"Could not open %1: %2"_s.arg(QFile::decodeName(lockFileName), QString::fromLocal8Bit(strerror(errno))));
+    int ret;
+    do {
+        ret = ::flock(lockFd, LOCK_EX);
+    } while (ret < 0 && errno == EINTR);
+    if (ret < 0) {
+        const int error = errno;
+        ::close(lockFd);
+        return fail(u"Could not lock %1: %2"_s.arg(QFile::decodeName(lockFileName), QString::fromLocal8Bit(strerror(error))));
+    }
+
+    mLockFd = lockFd;
+    return true;
+}
+
+void MatMimeAppsWriter::unlock()
+{
+    if (mLockFd >= 0) {
+        ::close(mLockFd); // Releases the lock
+        mLockFd = -1;
+    }
+}
+
+bool MatMimeAppsWriter::commit(QString *errorMessage)
+{
+    auto fail = [this, errorMessage](const QString &message) {
+        mChanges.clear();
+        unlock();
+        if (errorMessage != nullptr)
+            *errorMessage = message;
+        return false;
+    };
+
+    if (mChanges.isEmpty()) {
+        unlock();
+        return true;
+    }
+
+    QString lockError;
+    if (!lock(&lockError))
+        return fail(lockError);
+
+    QByteArray data;
+    QFile file(mFileName);
+    if (file.exists()) {
+        if (!file.open(QIODevice::ReadOnly))
+            return fail(u"Could not read %1"_s.arg(mFileName));
+        data = file.readAll();
+        file.close();
+    }
+
+    MatMimeAppsList current(mFileName);
+    current.parse(data);
+    const QByteArray result = patched(data, patches(current));
+    mChanges.clear();
+
+    if (result != data) {
+        QSaveFile out(mFileName);
+        if (!out.open(QIODevice::WriteOnly) || out.write(result) != result.size() || !out.commit())
+            return fail(u"Could not write %1: %2"_s.arg(mFileName, out.errorString()));
+    }
+
+    unlock();
+    return true;
+}
+
+QString MatMimeAppsWriter::defaultFileName()
+{
+    return XdgDirs::configHome(true) + "/mimeapps.list"_L1;
+}
+
+QHash<MatMimeAppsWriter::Key, QStringList> MatMimeAppsWriter::patches(const MatMimeAppsList &current) const
+{
+    QHash<Key, QStringList> patches;
+    auto value = [&patches, &current](MatMimeAppsList::Group group, const QString &mimeType) {
+        const auto it = patches.constFind(Key(group, mimeType));
+        return it != patches.constEnd() ? *it : current.apps(group, mimeType);
+    };
+
+    for (const Change &change : mChanges) {
+        if (!change.setDefault) {
+            patches.insert(Key(change.group, change.mimeType), change.ids);
+            continue;
+        }
+
+        const QString &id = change.ids.constFirst();
+        patches.insert(Key(MatMimeAppsList::DefaultApplications, change.mimeType), change.ids);
+
+        QStringList added = value(MatMimeAppsList::AddedAssociations, change.mimeType);
+        added.removeAll(id);
+        added.prepend(id);
+        patches.insert(Key(MatMimeAppsList::AddedAssociations, change.mimeType), added);
+
+        QStringList removed = value(MatMimeAppsList::RemovedAssociations, change.mimeType);
+        if (removed.removeAll(id) > 0)
+            patches.insert(Key(MatMimeAppsList::RemovedAssociations, change.mimeType), removed);
+    }
+
+    // Leave the entries that don't change alone, even if spelled differently
+    for (auto it = patches.begin(); it != patches.end();) {
+        if (it.value() == current.apps(static_cast<MatMimeAppsList::Group>(it.key().first), it.key().second))
+            it = patches.erase(it);
+        else
+            ++it;
+    }
+    return patches;
+}
+
+QByteArray MatMimeAppsWriter::patched(const QByteArray &data, const QHash<Key, QStringList> &patches)
+{
+    if (patches.isEmpty())
+        return data;
+
+    QList<QByteArray> lines;
+    QSet<Key> written;
+    bool seenGroup[3] = {false, false, false};
+    int group = -1;
+    qsizetype sectionEnd = 0; // Where new keys go in the current section
+
+    // New keys of a group go at the end of its first section
+    auto flushSection = [&]() {
+        if (group < 0 || seenGroup[group])
+            return;
+        seenGroup[group] = true;
+        QStringList mimeTypes;
+        for (auto it = patches.cbegin(); it != patches.cend(); ++it) {
+            if (it.key().first == group && !written.contains(it.key()) && !it.value().isEmpty())
+                mimeTypes.append(it.key().second);
+        }
+        std::sort(mimeTypes.begin(), mimeTypes.end());
+        for (const QString &mimeType : std::as_const(mimeTypes)) {
+            const Key key(group, mimeType);
+            lines.insert(sectionEnd++, entryLine(mimeType, patches.value(key)));
+            written.insert(key);
+        }
+    };
+
+    qsizetype begin = 0;
+    while (begin < data.size()) {
+        qsizetype end = data.indexOf('\n', begin);
+        if (end < 0)
+            end = data.size();
+        const QByteArray line = data.mid(begin, end - begin);
+        begin = end + 1;
+        const QByteArrayView trimmed = QByteArrayView(line).trimmed();
+
+        if (trimmed.startsWith('[')) {
+            flushSection();
+            group = groupOfHeader(trimmed);
+            lines.append(line);
+            sectionEnd = lines.size();
+            continue;
+        }
+
+        const qsizetype eq = trimmed.indexOf('=');
+        if (group >= 0 && eq > 0 && !trimmed.startsWith('#')) {
+            const Key key(group, QString::fromUtf8(trimmed.first(eq).trimmed()));
+            const auto it = patches.constFind(key);
+            if (it != patches.constEnd()) {
+                // Later duplicates of a patched key go away
+                if (!written.contains(key) && !it.value().isEmpty())
+                    lines.append(entryLine(key.second, it.value()));
+                written.insert(key);
+                if (!it.value().isEmpty())
+                    sectionEnd = lines.size();
+                continue;
+            }
+        }
+
+        lines.append(line);
+        if (!trimmed.isEmpty())
+            sectionEnd = lines.size();
+    }
+    flushSection();
+
+    // Groups missing from the file are appended
+    for (group = MatMimeAppsList::DefaultApplications; group <= MatMimeAppsList::RemovedAssociations; ++group) {
+        if (seenGroup[group])
+            continue;
+        bool needed = false;
+        for (auto it = patches.cbegin(); it != patches.cend() && !needed; ++it)
+            needed = it.key().first == group && !it.value().isEmpty();
+        if (!needed)
+            continue;
+
+        if (!lines.isEmpty() && !lines.constLast().trimmed().isEmpty())
+            lines.append(QByteArray());
+        const QLatin1StringView name = MatMimeAppsList::groupName(static_cast<MatMimeAppsList::Group>(group));
+        lines.append('[' + QByteArray(name.data(), name.size()) + ']');
+        sectionEnd = lines.size();
+        flushSection();
+    }
+
+    return lines.join('\n') + '\n';
+}
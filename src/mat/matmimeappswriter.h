@@ -0,0 +1,127 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#ifndef MATMIMEAPPSWRITER_H
+#define MATMIMEAPPSWRITER_H
+
+#include "matmimeappslist.h"
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+
+/*!
+ * \brief The MatMimeAppsWriter class applies a batch of changes to a
+ * mimeapps.list in one transaction.
+ *
+ * commit() takes an exclusive flock() on a lock file next to the list, so
+ * concurrent writers queue up instead of overwriting each other. The file is
+ * reread under the lock, only the changed keys are rewritten, everything else
+ * (comments, other groups, key order) is kept, and the result atomically
+ * replaces the old file.
+ */
+class MatMimeAppsWriter {
+
+public:
+    /*!
+     * \brief MatMimeAppsWriter
+     * \param fileName The mimeapps.list to change, see defaultFileName()
+     */
+    explicit MatMimeAppsWriter(const QString &fileName = defaultFileName());
+
+    /*!
+     * \brief ~MatMimeAppsWriter Releases the lock, if still held
+     */
+    ~MatMimeAppsWriter();
+    Q_DISABLE_COPY_MOVE(MatMimeAppsWriter)
+
+    /*!
+     * \brief fileName
+     * \return
+     */
+    inline QString fileName() const { return mFileName; }
+
+    /*!
+     * \brief setDefaultApp Makes \a id the default for \a mimeType
+     *
+     * Like GLib does, \a id also becomes the first added association and is
+     * dropped from the removed associations of \a mimeType.
+     * \param mimeType
+     * \param id A desktop id
+     */
+    void setDefaultApp(const QString &mimeType, const QString &id);
+
+    /*!
+     * \brief setApps Replaces one entry
+     * \param group
+     * \param mimeType
+     * \param ids The new value, an empty list removes the entry
+     */
+    void setApps(MatMimeAppsList::Group group, const QString &mimeType, const QStringList &ids);
+
+    /*!
+     * \brief lock Takes the lock commit() would take, and keeps it until
+     * commit() returns
+     *
+     * For changes computed from the current state, which must not change
+     * before they are written.
+     * \param errorMessage Set on failure, may be nullptr
+     * \return false if the list couldn't be locked
+     */
+    bool lock(QString *errorMessage = nullptr);
+
+    /*!
+     * \brief commit Writes the pending changes
+     * \param errorMessage Set on failure, may be nullptr
+     * \return false if the list couldn't be locked, read or written. The
+     * pending changes are dropped and the lock released either way.
+     */
+    bool commit(QString *errorMessage = nullptr);
+
+    /*!
+     * \brief defaultFileName
+     * \return The mimeapps.list of XDG_CONFIG_HOME
+     */
+    static QString defaultFileName();
+
+private:
+    using Key = QPair<int, QString>;
+
+    struct Change {
+        bool setDefault;
+        MatMimeAppsList::Group group;
+        QString mimeType;
+        QStringList ids;
+    };
+
+    QHash<Key, QStringList> patches(const MatMimeAppsList &current) const;
+    static QByteArray patched(const QByteArray &data, const QHash<Key, QStringList> &patches);
+
+    void unlock();
+
+    QString mFileName;
+    QList<Change> mChanges;
+    int mLockFd;
+};
+
+#endif // MATMIMEAPPSWRITER_H
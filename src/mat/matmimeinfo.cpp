@@ -0,0 +1,71 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "matmimeinfo.h"
+
+#include <QMimeDatabase>
+#include <QMimeType>
+
+using namespace Qt::Literals::StringLiterals;
+
+const MatMimeInfo::Info &MatMimeInfo::info(const QString &mimeType)
+{
+    const auto it = mCache.constFind(mimeType);
+    if (it != mCache.constEnd())
+        return *it;
+
+    Info info;
+    const QMimeType mt = database()->mimeTypeForName(mimeType);
+    if (mt.isValid()) {
+        info.valid = true;
+        info.name = mt.name();
+        info.comment = mt.comment();
+        info.iconName = mt.iconName();
+        info.genericIconName = mt.genericIconName();
+        info.parents = mt.parentMimeTypes();
+    }
+    return *mCache.insert(mimeType, info);
+}
+
+QList<QStringList> MatMimeInfo::lookupOrder(const QString &mimeType)
+{
+    const QMimeType mt = database()->mimeTypeForName(mimeType);
+    if (!mt.isValid())
+        return {QStringList() << mimeType};
+
+    QStringList canonical(mt.name());
+    QList<QStringList> order;
+    for (qsizetype i = 0; i < canonical.size(); ++i) {
+        const QMimeType type = database()->mimeTypeForName(canonical.at(i));
+        order.append(QStringList() << type.name() << type.aliases());
+        const QStringList parents = type.parentMimeTypes();
+        for (const QString &parent : parents) {
+            if (parent != "application/octet-stream"_L1 && !canonical.contains(parent))
+                canonical.append(parent);
+        }
+    }
+    return order;
+}
+
+QMimeDatabase *MatMimeInfo::database()
+{
+    static QMimeDatabase db;
+    return &db;
+}
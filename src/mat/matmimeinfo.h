@@ -0,0 +1,78 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#ifndef MATMIMEINFO_H
+#define MATMIMEINFO_H
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+class QMimeDatabase;
+
+/*!
+ * \brief The MatMimeInfo class looks up the metadata of mimetypes, each
+ * distinct mimetype once.
+ */
+class MatMimeInfo {
+
+public:
+    struct Info {
+        bool valid = false;
+        QString name; //!< The canonical name, it may differ for aliases
+        QString comment;
+        QString iconName;
+        QString genericIconName;
+        QStringList parents;
+    };
+
+    /*!
+     * \brief info
+     * \param mimeType A mimetype name or alias
+     * \return The metadata, invalid if \a mimeType is unknown
+     */
+    const Info &info(const QString &mimeType);
+
+    /*!
+     * \brief lookupOrder The names a default application is looked up under
+     *
+     * As GLib, and so XdgMimeApps, does: the mimetype, then its ancestors
+     * breadth first. Each entry holds the canonical name followed by its
+     * aliases, any of them may key an association. The
+     * application/octet-stream parent Qt gives every file type is left out,
+     * GLib doesn't fall back to it.
+     * \param mimeType A mimetype name or alias
+     * \return The names of the mimetype and of each ancestor, only
+     * \a mimeType itself if it's unknown
+     */
+    static QList<QStringList> lookupOrder(const QString &mimeType);
+
+    /*!
+     * \brief database
+     * \return The QMimeDatabase all the commands share
+     */
+    static QMimeDatabase *database();
+
+private:
+    QHash<QString, Info> mCache;
+};
+
+#endif // MATMIMEINFO_H
@@ -0,0 +1,197 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "matoutput.h"
+
+#include <QStringList>
+
+using namespace Qt::Literals::StringLiterals;
+
+// Large enough that batch commands hit the stream a handful of times only
+static constexpr qsizetype BufferSize = 64 * 1024;
+
+static quint64 records = 0;
+
+MatOutput::MatOutput(FILE *stream)
+    : mStream(stream),
+      mFormat(TextFormat),
+      mEncoder(QStringEncoder::Utf8)
+{
+}
+
+MatOutput::~MatOutput()
+{
+    flush();
+}
+
+QCommandLineOption MatOutput::formatOption()
+{
+    return QCommandLineOption(QStringList() << u"format"_s,
+                u"Output format: text (default), json, tsv or nul"_s, u"format"_s, u"text"_s);
+}
+
+bool MatOutput::formatFromName(const QString &name, Format *format)
+{
+    if (name == "text"_L1)
+        *format = TextFormat;
+    else if (name == "json"_L1)
+        *format = JsonFormat;
+    else if (name == "tsv"_L1)
+        *format = TsvFormat;
+    else if (name == "nul"_L1)
+        *format = NulFormat;
+    else
+        return false;
+    return true;
+}
+
+void MatOutput::write(std::initializer_list<Field> fields, QStringView text)
+{
+    ++records;
+    mLine.resize(0);
+
+    switch (mFormat) {
+    case TextFormat:
+        if (!text.isNull()) {
+            mLine.append(text);
+        } else {
+            bool first = true;
+            for (const Field &field : fields) {
+                if (!first)
+                    mLine.append(u'\t');
+                mLine.append(field.value);
+                first = false;
+            }
+        }
+        mLine.append(u'\n');
+        break;
+    case JsonFormat: {
+        bool first = true;
+        mLine.append(u'{');
+        for (const Field &field : fields) {
+            if (!first)
+                mLine.append(u',');
+            mLine.append(u'"');
+            mLine.append(field.key);
+            mLine.append("\":\""_L1);
+            appendEscaped(field.value);
+            mLine.append(u'"');
+            first = false;
+        }
+        mLine.append("}\n"_L1);
+        break;
+    }
+    case TsvFormat:
+    case NulFormat: {
+        bool first = true;
+        for (const Field &field : fields) {
+            if (!first)
+                mLine.append(u'\t');
+            appendEscaped(field.value);
+            first = false;
+        }
+        // A NUL can't be part of a field, so it always ends a record
+        mLine.append(mFormat == NulFormat ? QChar(0) : QChar(u'\n'));
+        break;
+    }
+    }
+
+    commitLine();
+}
+
+void MatOutput::writeText(QStringView text)
+{
+    if (mFormat != TextFormat)
+        return;
+
+    mLine.resize(0);
+    mLine.append(text);
+    mLine.append(u'\n');
+    commitLine();
+}
+
+void MatOutput::flush()
+{
+    if (mBuffer.isEmpty())
+        return;
+
+    fwrite(mBuffer.constData(), 1, size_t(mBuffer.size()), mStream);
+    fflush(mStream);
+    mBuffer.resize(0);
+}
+
+void MatOutput::appendEscaped(QStringView value)
+{
+    for (const QChar c : value) {
+        const char16_t u = c.unicode();
+        switch (u) {
+        case u'\\':
+            mLine.append("\\\\"_L1);
+            break;
+        case u'\t':
+            mLine.append("\\t"_L1);
+            break;
+        case u'\n':
+            mLine.append("\\n"_L1);
+            break;
+        case u'\r':
+            mLine.append("\\r"_L1);
+            break;
+        case u'\0':
+            // Would end a nul record early, json has its own \u0000
+            if (mFormat == JsonFormat)
+                mLine.append("\\u0000"_L1);
+            else
+                mLine.append("\\0"_L1);
+            break;
+        case u'"':
+            if (mFormat == JsonFormat)
+                mLine.append("\\\""_L1);
+            else
+                mLine.append(c);
+            break;
+        default:
+            if (u < 0x20 && mFormat == JsonFormat)
+                mLine.append(u"\\u%1"_s.arg(int(u), 4, 16, u'0'));
+            else
+                mLine.append(c);
+        }
+    }
+}
+
+quint64 MatOutput::recordCount()
+{
+    return records;
+}
+
+void MatOutput::commitLine()
+{
+    // On the first record only, a command printing nothing allocates nothing
+    if (mBuffer.capacity() == 0)
+        mBuffer.reserve(BufferSize);
+
+    const qsizetype offset = mBuffer.size();
+    mBuffer.resize(offset + mEncoder.requiredSpace(mLine.size()));
+    char *end = mEncoder.appendToBuffer(mBuffer.data() + offset, mLine);
+    mBuffer.resize(end - mBuffer.constData());
+
+    if (mBuffer.size() >= BufferSize)
+        flush();
+}
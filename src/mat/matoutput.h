@@ -0,0 +1,145 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#ifndef MATOUTPUT_H
+#define MATOUTPUT_H
+
+#include <QByteArray>
+#include <QCommandLineOption>
+#include <QLatin1StringView>
+#include <QString>
+#include <QStringEncoder>
+
+#include <cstdio>
+#include <initializer_list>
+
+/*!
+ * \brief The MatOutput class is the buffered result writer shared by the
+ * commands.
+ *
+ * A result is written as one record of named fields. Each record is built
+ * in a reusable QString, UTF-8 encoded once, straight into an output buffer
+ * that is only written to the stream when it fills up or on flush().
+ *
+ * The formats are:
+ * \list
+ * \li text - the historical, human readable, output
+ * \li json - one JSON object per line
+ * \li tsv  - tab separated values, one record per line. Tabs, newlines,
+ *            NULs and backslashes are escaped as \t, \n, \0 and \\
+ * \li nul  - tab separated values, escaped as for tsv, and every record
+ *            terminated by a NUL byte
+ * \endlist
+ */
+class MatOutput {
+
+public:
+    enum Format {
+        TextFormat,
+        JsonFormat,
+        TsvFormat,
+        NulFormat
+    };
+
+    struct Field {
+        QLatin1StringView key;
+        QStringView value;
+    };
+
+    /*!
+     * \brief MatOutput
+     * \param stream The stream the buffer is flushed to
+     */
+    explicit MatOutput(FILE *stream = stdout);
+
+    /*!
+     * \brief ~MatOutput Flushes the pending records
+     */
+    virtual ~MatOutput();
+
+    /*!
+     * \brief format
+     * \return
+     */
+    inline Format format() const { return mFormat; }
+
+    /*!
+     * \brief setFormat
+     * \param format
+     */
+    inline void setFormat(Format format) { mFormat = format; }
+
+    /*!
+     * \brief isStructured
+     * \return true unless the format is TextFormat
+     */
+    inline bool isStructured() const { return mFormat != TextFormat; }
+
+    /*!
+     * \brief formatOption
+     * \return The --format option, to be added by every command parser
+     */
+    static QCommandLineOption formatOption();
+
+    /*!
+     * \brief formatFromName
+     * \param name "text", "json", "tsv" or "nul"
+     * \param format
+     * \return false if \a name isn't a known format
+     */
+    static bool formatFromName(const QString &name, Format *format);
+
+    /*!
+     * \brief write Writes one record
+     * \param fields The record fields
+     * \param text The line printed in TextFormat. If null, the field values
+     * are printed separated by tabs.
+     */
+    void write(std::initializer_list<Field> fields, QStringView text = QStringView());
+
+    /*!
+     * \brief writeText Writes a line in TextFormat only
+     * \param text
+     */
+    void writeText(QStringView text);
+
+    /*!
+     * \brief flush Writes the buffer to the stream
+     */
+    void flush();
+
+    /*!
+     * \brief recordCount
+     * \return The records written by every MatOutput of the process
+     */
+    static quint64 recordCount();
+
+private:
+    void appendEscaped(QStringView value);
+    void commitLine();
+
+    FILE *mStream;
+    Format mFormat;
+    QString mLine;
+    QByteArray mBuffer;
+    QStringEncoder mEncoder;
+};
+
+#endif // MATOUTPUT_H
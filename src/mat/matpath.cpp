@@ -0,0 +1,76 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "matpath.h"
+
+#include <QStringEncoder>
+
+#include <sys/stat.h>
+
+static inline bool isAsciiLetter(QChar c)
+{
+    return (c >= u'a' && c <= u'z') || (c >= u'A' && c <= u'Z');
+}
+
+MatPath::MatPath() = default;
+
+MatPath::~MatPath() = default;
+
+const char *MatPath::encode(QStringView path)
+{
+    encode(path, &mBuffer);
+    return mBuffer.constData();
+}
+
+void MatPath::encode(QStringView path, QByteArray *buffer)
+{
+    QStringEncoder encoder(QStringEncoder::Utf8);
+    buffer->resize(encoder.requiredSpace(path.size()));
+    char *end = encoder.appendToBuffer(buffer->data(), path);
+    buffer->resize(end - buffer->constData()); // QByteArray keeps the NUL terminator
+}
+
+bool MatPath::stat(QStringView path, struct stat *st)
+{
+    return ::stat(encode(path), st) == 0;
+}
+
+bool MatPath::exists(QStringView path)
+{
+    struct stat st;
+    return stat(path, &st);
+}
+
+QStringView MatPath::urlScheme(QStringView s)
+{
+    const qsizetype colon = s.indexOf(u':');
+    // A single letter is rather a drive, a colon first isn't a scheme at all
+    if (colon < 2)
+        return QStringView();
+
+    if (!isAsciiLetter(s.at(0)))
+        return QStringView();
+    for (qsizetype i = 1; i < colon; ++i) {
+        const QChar c = s.at(i);
+        if (!isAsciiLetter(c) && !(c >= u'0' && c <= u'9') && c != u'+' && c != u'-' && c != u'.')
+            return QStringView();
+    }
+    return s.first(colon);
+}
@@ -0,0 +1,85 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#ifndef MATPATH_H
+#define MATPATH_H
+
+#include <QByteArray>
+#include <QStringView>
+
+struct stat;
+
+/*!
+ * \brief The MatPath class probes command line paths without the QUrl,
+ * QFileInfo and QByteArray temporaries of the per item batch loops.
+ *
+ * Paths are encoded into one buffer, reused by every call.
+ */
+class MatPath {
+
+public:
+    MatPath();
+    virtual ~MatPath();
+
+    /*!
+     * \brief encode
+     * \param path
+     * \return \a path, UTF-8 encoded and NUL terminated. It's valid until the
+     * next call.
+     */
+    const char *encode(QStringView path);
+
+    /*!
+     * \brief encode Encodes \a path into \a buffer, reusing its capacity
+     * \param path
+     * \param buffer UTF-8 encoded and NUL terminated \a path
+     */
+    static void encode(QStringView path, QByteArray *buffer);
+
+    /*!
+     * \brief stat
+     * \param path
+     * \param st
+     * \return false if \a path can't be stat'ed
+     */
+    bool stat(QStringView path, struct stat *st);
+
+    /*!
+     * \brief exists
+     * \param path
+     * \return true if \a path exists
+     */
+    bool exists(QStringView path);
+
+    /*!
+     * \brief urlScheme
+     *
+     * The RFC 3986 scheme, or an empty view. QUrl is too lenient or too
+     * strict depending on the rest of the string, e.g. with "mailto:a@b".
+     * \param s
+     * \return The scheme, as written, of at least two characters
+     */
+    static QStringView urlScheme(QStringView s);
+
+private:
+    QByteArray mBuffer;
+};
+
+#endif // MATPATH_H
@@ -0,0 +1,74 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "matrecorder.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QProcessEnvironment>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace Qt::Literals::StringLiterals;
+
+MatRecorder::MatRecorder()
+    : mFileName(qEnvironmentVariable("QTXDG_MAT_RECORD")),
+      mStartTime(0)
+{
+    if (!isEnabled())
+        return;
+    mStartTime = QDateTime::currentMSecsSinceEpoch();
+    mTimer.start();
+}
+
+void MatRecorder::record(const QStringList &arguments, int exitCode)
+{
+    if (!isEnabled())
+        return;
+
+    const qint64 wallTime = mTimer.nsecsElapsed() / 1000;
+
+    QJsonObject env;
+    const QProcessEnvironment systemEnv = QProcessEnvironment::systemEnvironment();
+    const QStringList keys = systemEnv.keys();
+    for (const QString &key : keys) {
+        if (key.startsWith("XDG_"_L1))
+            env.insert(key, systemEnv.value(key));
+    }
+
+    QJsonObject entry;
+    entry.insert("time"_L1, mStartTime);
+    entry.insert("wall_us"_L1, wallTime);
+    entry.insert("argv"_L1, QJsonArray::fromStringList(arguments));
+    entry.insert("env"_L1, env);
+    entry.insert("exit"_L1, exitCode);
+    const QByteArray line = QJsonDocument(entry).toJson(QJsonDocument::Compact) + '\n';
+
+    const int fd = ::open(QFile::encodeName(mFileName).constData(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0600);
+    if (fd < 0)
+        return; // recording must never break the command
+    if (::write(fd, line.constData(), line.size()) != line.size())
+        qWarning("MatRecorder: short write to %s", qPrintable(mFileName));
+    ::close(fd);
+}
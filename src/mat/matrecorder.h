@@ -0,0 +1,64 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#ifndef MATRECORDER_H
+#define MATRECORDER_H
+
+#include <QElapsedTimer>
+#include <QString>
+#include <QStringList>
+
+/*!
+ * \brief The MatRecorder class logs the invocations of qtxdg-mat, so real
+ * session traffic can be replayed later with qtxdg-mat-replay.
+ *
+ * It is enabled by QTXDG_MAT_RECORD, naming the log file. Every invocation
+ * appends one JSON line: its start time, wall time, arguments, XDG_*
+ * environment variables and exit code. Lines are appended with a single
+ * write() to an O_APPEND file, so concurrent invocations don't interleave.
+ */
+class MatRecorder {
+
+public:
+    /*!
+     * \brief MatRecorder Starts timing the invocation
+     */
+    MatRecorder();
+
+    /*!
+     * \brief isEnabled
+     * \return true if QTXDG_MAT_RECORD is set
+     */
+    inline bool isEnabled() const { return !mFileName.isEmpty(); }
+
+    /*!
+     * \brief record Appends the invocation to the log, if enabled
+     * \param arguments The arguments, without the program name
+     * \param exitCode
+     */
+    void record(const QStringList &arguments, int exitCode);
+
+private:
+    QString mFileName;
+    qint64 mStartTime; //!< ms since the epoch
+    QElapsedTimer mTimer;
+};
+
+#endif // MATRECORDER_H
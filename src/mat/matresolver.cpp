@@ -0,0 +1,180 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "matresolver.h"
+
+#include "matdesktopdb.h"
+#include "matmimeappslist.h"
+#include "matmimeinfo.h"
+
+#include <QSet>
+
+MatResolver::MatResolver(const QList<MatMimeAppsLayers *> &layers, const QList<MatDesktopDb *> &dbs)
+    : mLayers(layers),
+      mDbs(dbs)
+{
+}
+
+const MatDesktopEntry *MatResolver::entry(const QString &id) const
+{
+    for (MatDesktopDb *db : mDbs) {
+        if (db->hasFile(id))
+            return db->entry(id);
+    }
+    return nullptr;
+}
+
+QList<const MatMimeAppsList *> MatResolver::lists() const
+{
+    QList<const MatMimeAppsList *> lists;
+    for (MatMimeAppsLayers *layers : mLayers)
+        lists.append(layers->layers());
+    return lists;
+}
+
+const MatDesktopEntry *MatResolver::defaultApp(const QString &mimeType) const
+{
+    const QList<const MatMimeAppsList *> lists = this->lists();
+
+    // The removed associations met on the way keep hiding applications from
+    // the ancestors, as in GLib
+    QSet<QString> removed;
+    const QList<QStringList> order = MatMimeInfo::lookupOrder(mimeType);
+    for (const QStringList &names : order) {
+        if (const MatDesktopEntry *app = defaultApp(lists, names, &removed))
+            return app;
+    }
+    return nullptr;
+}
+
+const MatDesktopEntry *MatResolver::defaultApp(const QList<const MatMimeAppsList *> &lists, const QStringList &names,
+                                               QSet<QString> *removed) const
+{
+    for (const MatMimeAppsList *list : lists) {
+        for (const QString &name : names) {
+            const QStringList ids = list->apps(MatMimeAppsList::DefaultApplications, name);
+            for (const QString &id : ids) {
+                if (const MatDesktopEntry *app = entry(id))
+                    return app;
+            }
+        }
+    }
+
+    // Removed associations hide the associations of less important layers
+    for (const MatMimeAppsList *list : lists) {
+        for (const QString &name : names) {
+            const QStringList ids = list->apps(MatMimeAppsList::AddedAssociations, name);
+            for (const QString &id : ids) {
+                if (removed->contains(id))
+                    continue;
+                if (const MatDesktopEntry *app = entry(id))
+                    return app;
+            }
+        }
+        for (const QString &name : names) {
+            const QStringList removedIds = list->apps(MatMimeAppsList::RemovedAssociations, name);
+            for (const QString &id : removedIds)
+                removed->insert(id);
+        }
+    }
+
+    for (qsizetype i = 0; i < mDbs.size(); ++i) {
+        for (const QString &name : names) {
+            const QList<const MatDesktopEntry *> apps = mDbs.at(i)->entriesForMimeType(name);
+            for (const MatDesktopEntry *app : apps) {
+                if (removed->contains(app->id))
+                    continue;
+
+                bool shadowed = false;
+                for (qsizetype j = 0; j < i && !shadowed; ++j)
+                    shadowed = mDbs.at(j)->hasFile(app->id);
+                if (!shadowed)
+                    return app;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+QList<MatResolver::Candidate> MatResolver::candidates(const QString &mimeType) const
+{
+    const QList<const MatMimeAppsList *> lists = this->lists();
+    QList<Candidate> result;
+    QSet<QString> seen;
+
+    for (const MatMimeAppsList *list : std::as_const(lists)) {
+        const QStringList ids = list->apps(MatMimeAppsList::DefaultApplications, mimeType);
+        for (const QString &id : ids) {
+            if (seen.contains(id))
+                continue;
+            if (const MatDesktopEntry *app = entry(id)) {
+                seen.insert(id);
+                result.append(Candidate{app, DefaultSource});
+            }
+        }
+    }
+
+    QSet<QString> removed;
+    for (const MatMimeAppsList *list : std::as_const(lists)) {
+        const QStringList ids = list->apps(MatMimeAppsList::AddedAssociations, mimeType);
+        for (const QString &id : ids) {
+            if (removed.contains(id) || seen.contains(id))
+                continue;
+            if (const MatDesktopEntry *app = entry(id)) {
+                seen.insert(id);
+                result.append(Candidate{app, AddedSource});
+            }
+        }
+        const QStringList removedIds = list->apps(MatMimeAppsList::RemovedAssociations, mimeType);
+        for (const QString &id : removedIds)
+            removed.insert(id);
+    }
+
+    for (qsizetype i = 0; i < mDbs.size(); ++i) {
+        const QList<const MatDesktopEntry *> apps = mDbs.at(i)->entriesForMimeType(mimeType);
+        for (const MatDesktopEntry *app : apps) {
+            if (removed.contains(app->id) || seen.contains(app->id))
+                continue;
+
+            bool shadowed = false;
+            for (qsizetype j = 0; j < i && !shadowed; ++j)
+                shadowed = mDbs.at(j)->hasFile(app->id);
+            if (!shadowed) {
+                seen.insert(app->id);
+                result.append(Candidate{app, DeclaredSource});
+            }
+        }
+    }
+
+    return result;
+}
+
+QSet<QString> MatResolver::removedApps(const QString &mimeType) const
+{
+    QSet<QString> removed;
+    const QList<const MatMimeAppsList *> lists = this->lists();
+    for (const MatMimeAppsList *list : lists) {
+        const QStringList ids = list->apps(MatMimeAppsList::RemovedAssociations, mimeType);
+        for (const QString &id : ids)
+            removed.insert(id);
+    }
+    return removed;
+}
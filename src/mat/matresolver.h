@@ -0,0 +1,112 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#ifndef MATRESOLVER_H
+#define MATRESOLVER_H
+
+#include <QList>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+class MatDesktopDb;
+class MatMimeAppsLayers;
+class MatMimeAppsList;
+struct MatDesktopEntry;
+
+/*!
+ * \brief The MatResolver class resolves mimetype associations over stacked
+ * mimeapps.list layers and desktop databases.
+ *
+ * Nothing is owned. The same system layers and database can be shared by
+ * any number of resolvers, each one stacking a different user on top of
+ * them.
+ */
+class MatResolver {
+
+public:
+    enum Source {
+        DefaultSource,  //!< From [Default Applications]
+        AddedSource,    //!< From [Added Associations]
+        DeclaredSource  //!< From the desktop file MimeType key
+    };
+
+    struct Candidate {
+        const MatDesktopEntry *entry;
+        Source source;
+    };
+
+    /*!
+     * \brief MatResolver
+     * \param layers The mimeapps.list stacks, most important first
+     * \param dbs The desktop databases, most important first
+     */
+    MatResolver(const QList<MatMimeAppsLayers *> &layers, const QList<MatDesktopDb *> &dbs);
+
+    /*!
+     * \brief entry
+     * \param id
+     * \return The installed application \a id, honoring shadowing between
+     * the databases, or nullptr
+     */
+    const MatDesktopEntry *entry(const QString &id) const;
+
+    /*!
+     * \brief defaultApp
+     *
+     * The first installed application of the Default Applications groups
+     * wins. Otherwise the Added Associations, then the applications
+     * declaring \a mimeType, minus the Removed Associations. If none, the
+     * same goes for each ancestor of \a mimeType. Aliases key the same
+     * associations as the canonical name. That is the XdgMimeApps order, see
+     * MatMimeInfo::lookupOrder().
+     * \param mimeType
+     * \return The default application or nullptr
+     */
+    const MatDesktopEntry *defaultApp(const QString &mimeType) const;
+
+    /*!
+     * \brief candidates
+     *
+     * Every application defaultApp() would consider for \a mimeType itself,
+     * in the same order and without duplicates. Unless defaultApp() fell back
+     * to an ancestor, the first one is the defaultApp().
+     * \param mimeType
+     * \return The installed candidates for exactly \a mimeType
+     */
+    QList<Candidate> candidates(const QString &mimeType) const;
+
+    /*!
+     * \brief removedApps
+     * \param mimeType
+     * \return The ids of the Removed Associations of \a mimeType in any layer
+     */
+    QSet<QString> removedApps(const QString &mimeType) const;
+
+private:
+    QList<const MatMimeAppsList *> lists() const;
+    const MatDesktopEntry *defaultApp(const QList<const MatMimeAppsList *> &lists, const QStringList &names,
+                                      QSet<QString> *removed) const;
+
+    QList<MatMimeAppsLayers *> mLayers;
+    QList<MatDesktopDb *> mDbs;
+};
+
+#endif // MATRESOLVER_H
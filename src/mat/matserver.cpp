@@ -0,0 +1,747 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "matserver.h"
+
+#include "matdbusactivation.h"
+#include "matdesktopdb.h"
+#include "matlauncher.h"
+#include "matmimeappslist.h"
+#include "matresolver.h"
+#include "matwatcher.h"
+#include "xdgdesktopfile.h"
+#include "xdgdirs.h"
+
+#include <QCryptographicHash>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QMimeType>
+#include <QProcessEnvironment>
+#include <QRegularExpression>
+#include <QSocketNotifier>
+#include <QTimer>
+#include <QUrl>
+
+#include <algorithm>
+#include <cstring>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <pwd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace Qt::Literals::StringLiterals;
+
+// Overlays kept in memory, the least recently used ones are dropped first
+static constexpr qsizetype MaxOverlays = 1024;
+// A client sending longer lines is disconnected
+static constexpr qsizetype MaxLineLength = 64 * 1024;
+// A client not reading its replies is disconnected once this much is pending
+static constexpr qsizetype MaxPendingOutput = 1024 * 1024;
+// Entries of a user's applications directory tree checked for changes
+static constexpr int MaxStampEntries = 16 * 1024;
+static constexpr int MaxStampDepth = 8;
+// Period of the Prometheus metrics file updates
+static constexpr int MetricsInterval = 10 * 1000;
+
+struct MatServer::Client {
+    int inFd = -1;
+    int outFd = -1;
+    bool stdio = false;
+    uid_t uid = 0;
+    bool envRejected = false; //!< Its directories would resolve someone else's
+    bool closing = false; //!< Closed once the pending replies are written
+    QString configHome;
+    QString dataHome;
+    QStringList desktops;
+    QByteArray in;
+    QByteArray out;
+    QSocketNotifier *readNotifier = nullptr;
+    QSocketNotifier *writeNotifier = nullptr;
+};
+
+struct MatServer::UserOverlay {
+    // Layers read for another user must be that user's files
+    UserOverlay(const QString &configHome, const QString &dataHome, const QStringList &desktops, qint64 owner)
+        : configLayers(MatMimeAppsLayers::layerFileNames(QStringList() << configHome, desktops)),
+          dataLayers(MatMimeAppsLayers::layerFileNames(QStringList() << dataHome + "/applications"_L1, desktops)),
+          db(QStringList() << dataHome + "/applications"_L1),
+          lastUse(0)
+    {
+        configLayers.setOwner(owner);
+        dataLayers.setOwner(owner);
+        db.setOwner(owner);
+    }
+
+    MatMimeAppsLayers configLayers;
+    MatMimeAppsLayers dataLayers;
+    MatDesktopDb db;
+    QByteArray appsStamp; //!< treeStamp() of the applications directory
+    quint64 lastUse;
+};
+
+struct MatServer::SystemLayers {
+    SystemLayers(const QStringList &desktops)
+        : configLayers(MatMimeAppsLayers::layerFileNames(XdgDirs::configDirs(), desktops)),
+          dataLayers(MatMimeAppsLayers::layerFileNames(systemApplicationsDirs(), desktops))
+    {
+    }
+
+    static QStringList systemApplicationsDirs()
+    {
+        QStringList dirs;
+        const QStringList dataDirs = XdgDirs::dataDirs();
+        for (const QString &dir : dataDirs)
+            dirs.append(dir + "/applications"_L1);
+        return dirs;
+    }
+
+    MatMimeAppsLayers configLayers;
+    MatMimeAppsLayers dataLayers;
+};
+
+static QString homeDir(uid_t uid)
+{
+    long size = sysconf(_SC_GETPW_R_SIZE_MAX);
+    if (size < 0)
+        size = 16384;
+
+    QByteArray buffer(size, Qt::Uninitialized);
+    passwd pwd;
+    passwd *result = nullptr;
+    if (getpwuid_r(uid, &pwd, buffer.data(), size_t(buffer.size()), &result) != 0 || result == nullptr)
+        return QString();
+    return QFile::decodeName(pwd.pw_dir);
+}
+
+// Hashes the name and mtime of every subdirectory and desktop file below the
+// directory \a dirFd, which it closes. Like the desktop database scan, it
+// stays on real directories and follows links to files.
+static void stampTree(int dirFd, QCryptographicHash *hash, int depth, int *entries)
+{
+    DIR *dir = ::fdopendir(dirFd);
+    if (dir == nullptr) {
+        ::close(dirFd);
+        return;
+    }
+
+    while (const dirent *e = ::readdir(dir)) {
+        const QByteArrayView name(e->d_name);
+        if (name.startsWith('.')) // hidden, QDirIterator skips them too
+            continue;
+
+        struct stat st;
+        if (::fstatat(::dirfd(dir), e->d_name, &st, AT_SYMLINK_NOFOLLOW) != 0)
+            continue;
+        const bool isDir = S_ISDIR(st.st_mode);
+        if (!isDir && (!name.endsWith(".desktop")
+                       || (S_ISLNK(st.st_mode) && ::fstatat(::dirfd(dir), e->d_name, &st, 0) != 0)))
+            continue;
+
+        if (--*entries < 0)
+            break;
+        hash->addData(name);
+        hash->addData(QByteArrayView(reinterpret_cast<const char *>(&st.st_mtim), sizeof(st.st_mtim)));
+        hash->addData(QByteArrayView(reinterpret_cast<const char *>(&st.st_ino), sizeof(st.st_ino)));
+        if (isDir && depth < MaxStampDepth) {
+            const int fd = ::openat(::dirfd(dir), e->d_name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC | O_NONBLOCK);
+            if (fd >= 0) {
+                hash->addData("/");
+                stampTree(fd, hash, depth + 1, entries);
+                hash->addData("\n");
+            }
+        }
+    }
+    ::closedir(dir);
+}
+
+// Changes when a desktop file anywhere below \a path is added, removed or
+// edited, which the mtime of \a path alone doesn't tell. Empty if \a path
+// isn't a directory.
+static QByteArray treeStamp(const QString &path)
+{
+    const int fd = ::open(QFile::encodeName(path).constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC | O_NONBLOCK);
+    if (fd < 0)
+        return QByteArray();
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    int entries = MaxStampEntries;
+    stampTree(fd, &hash, 0, &entries);
+    return hash.result();
+}
+
+static QStringList parseDesktops(const QString &value)
+{
+    // Desktop names become part of file names, keep them harmless
+    static const QRegularExpression validName(u"^[a-z0-9_-]+$"_s);
+
+    QStringList desktops;
+    const QStringList names = value.toLower().split(u':', Qt::SkipEmptyParts);
+    for (const QString &name : names) {
+        if (validName.match(name).hasMatch())
+            desktops.append(name);
+    }
+    return desktops;
+}
+
+static int listenUnix(const QString &socketPath, QString *errorMessage)
+{
+    const QByteArray path = QFile::encodeName(socketPath);
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    if (size_t(path.size()) >= sizeof(addr.sun_path)) {
+        *errorMessage = u"Socket path too long: %1"_s.arg(socketPath);
+        return -1;
+    }
+    memcpy(addr.sun_path, path.constData(), size_t(path.size()));
+
+    // Replace a stale socket, never anything else
+    struct stat st;
+    if (::lstat(path.constData(), &st) == 0 && S_ISSOCK(st.st_mode))
+        ::unlink(path.constData());
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    if (fd < 0
+            || ::bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0
+            || ::chmod(path.constData(), 0666) != 0
+            || ::listen(fd, SOMAXCONN) != 0) {
+        *errorMessage = u"Could not listen on '%1': %2"_s.arg(socketPath, QString::fromLocal8Bit(strerror(errno)));
+        if (fd >= 0)
+            ::close(fd);
+        fd = -1;
+    }
+    return fd;
+}
+
+MatServer::MatServer(QObject *parent)
+    : QObject(parent),
+      mListenFd(-1),
+      mListenNotifier(nullptr),
+      mMetricsFd(-1),
+      mMetricsTimer(nullptr),
+      mLauncher(nullptr),
+      mSystemDb(new MatDesktopDb(SystemLayers::systemApplicationsDirs())),
+      mWatcher(new MatWatcher(this)),
+      mUseCounter(0)
+{
+    mWatcher->setDesktopDb(mSystemDb);
+    const QStringList configDirs = XdgDirs::configDirs();
+    for (const QString &dir : configDirs)
+        mWatcher->watchDir(dir, MatWatcher::MimeAppsDir);
+    const QStringList applicationsDirs = SystemLayers::systemApplicationsDirs();
+    for (const QString &dir : applicationsDirs)
+        mWatcher->watchDir(dir, MatWatcher::ApplicationsDir);
+
+    connect(mWatcher, &MatWatcher::mimeAppsListChanged, this, [this](const QString &fileName) {
+        for (SystemLayers *layers : std::as_const(mSystemLayers)) {
+            layers->configLayers.invalidate(fileName);
+            layers->dataLayers.invalidate(fileName);
+        }
+    });
+
+    // Load the shared part once, up front
+    mSystemDb->entries();
+    SystemLayers *layers = systemLayers(parseDesktops(qEnvironmentVariable("XDG_CURRENT_DESKTOP")));
+    layers->configLayers.layers();
+    layers->dataLayers.layers();
+}
+
+MatServer::~MatServer()
+{
+    const QList<Client *> clients = mClients;
+    for (Client *client : clients)
+        closeClient(client);
+
+    if (mListenFd >= 0) {
+        ::close(mListenFd);
+        ::unlink(QFile::encodeName(mSocketPath).constData());
+    }
+    if (mMetricsFd >= 0) {
+        ::close(mMetricsFd);
+        ::unlink(QFile::encodeName(mMetricsSocketPath).constData());
+    }
+    if (!mMetricsFile.isEmpty())
+        writeMetricsFile();
+
+    qDeleteAll(mOverlays);
+    qDeleteAll(mSystemLayers);
+    delete mSystemDb;
+}
+
+bool MatServer::listen(const QString &socketPath, QString *errorMessage)
+{
+    mListenFd = listenUnix(socketPath, errorMessage);
+    if (mListenFd < 0)
+        return false;
+
+    mSocketPath = socketPath;
+    mListenNotifier = new QSocketNotifier(mListenFd, QSocketNotifier::Read, this);
+    connect(mListenNotifier, &QSocketNotifier::activated, this, &MatServer::acceptClients);
+    return true;
+}
+
+bool MatServer::listenMetrics(const QString &socketPath, QString *errorMessage)
+{
+    mMetricsFd = listenUnix(socketPath, errorMessage);
+    if (mMetricsFd < 0)
+        return false;
+
+    mMetricsSocketPath = socketPath;
+    QSocketNotifier *notifier = new QSocketNotifier(mMetricsFd, QSocketNotifier::Read, this);
+    connect(notifier, &QSocketNotifier::activated, this, &MatServer::acceptMetricsClients);
+    return true;
+}
+
+void MatServer::setMetricsFile(const QString &fileName)
+{
+    mMetricsFile = fileName;
+    if (mMetricsTimer == nullptr) {
+        mMetricsTimer = new QTimer(this);
+        connect(mMetricsTimer, &QTimer::timeout, this, &MatServer::writeMetricsFile);
+        mMetricsTimer->start(MetricsInterval);
+    }
+    writeMetricsFile();
+}
+
+void MatServer::writeMetricsFile()
+{
+    if (!mStats.writePrometheus(mMetricsFile))
+        qWarning("MatServer: could not write %s", qPrintable(mMetricsFile));
+}
+
+void MatServer::acceptMetricsClients()
+{
+    for (;;) {
+        const int fd = ::accept4(mMetricsFd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0)
+            return;
+
+        // Small enough for the socket buffer, a slow reader gets a truncated dump
+        const timeval timeout = {1, 0};
+        ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+        const QByteArray text = mStats.prometheus();
+        qsizetype sent = 0;
+        while (sent < text.size()) {
+            const ssize_t len = ::send(fd, text.constData() + sent, size_t(text.size() - sent), MSG_NOSIGNAL);
+            if (len <= 0)
+                break;
+            sent += len;
+        }
+        ::close(fd);
+    }
+}
+
+void MatServer::serveStdio()
+{
+    Client *client = new Client;
+    client->inFd = STDIN_FILENO;
+    client->outFd = STDOUT_FILENO;
+    client->stdio = true;
+    client->uid = ::getuid();
+    client->configHome = XdgDirs::configHome(false);
+    client->dataHome = XdgDirs::dataHome(false);
+    client->desktops = parseDesktops(qEnvironmentVariable("XDG_CURRENT_DESKTOP"));
+    client->readNotifier = new QSocketNotifier(client->inFd, QSocketNotifier::Read, this);
+    connect(client->readNotifier, &QSocketNotifier::activated, this, [this, client] { readClient(client); });
+    mClients.append(client);
+}
+
+void MatServer::acceptClients()
+{
+    for (;;) {
+        const int fd = ::accept4(mListenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0)
+            return;
+
+        ucred cred;
+        socklen_t len = sizeof(cred);
+        const QString home = ::getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) == 0
+                ? homeDir(cred.uid) : QString();
+        if (home.isEmpty()) {
+            ::close(fd);
+            continue;
+        }
+
+        Client *client = new Client;
+        client->inFd = fd;
+        client->outFd = fd;
+        client->uid = cred.uid;
+        client->configHome = home + "/.config"_L1;
+        client->dataHome = home + "/.local/share"_L1;
+        client->readNotifier = new QSocketNotifier(fd, QSocketNotifier::Read, this);
+        client->writeNotifier = new QSocketNotifier(fd, QSocketNotifier::Write, this);
+        client->writeNotifier->setEnabled(false);
+        connect(client->readNotifier, &QSocketNotifier::activated, this, [this, client] { readClient(client); });
+        connect(client->writeNotifier, &QSocketNotifier::activated, this, [this, client] { writeClient(client); });
+        mClients.append(client);
+    }
+}
+
+void MatServer::readClient(Client *client)
+{
+    char buffer[4096];
+    bool eof = false;
+    for (;;) {
+        const ssize_t len = ::read(client->inFd, buffer, sizeof(buffer));
+        if (len > 0) {
+            client->in.append(buffer, len);
+            // stdin is blocking, wait for the notifier to read more
+            if (client->stdio || len < qsizetype(sizeof(buffer)))
+                break;
+        } else {
+            eof = len == 0 || (errno != EAGAIN && errno != EINTR);
+            break;
+        }
+    }
+
+    qsizetype begin = 0;
+    while (client->out.size() <= MaxPendingOutput) {
+        const qsizetype end = client->in.indexOf('\n', begin);
+        if (end < 0)
+            break;
+        const QByteArray line = client->in.mid(begin, end - begin);
+        begin = end + 1;
+        client->out.append(handleRequest(client, line));
+        client->out.append('\n');
+    }
+    client->in.remove(0, begin);
+
+    // It keeps sending requests without reading the replies
+    if (client->out.size() > MaxPendingOutput) {
+        const bool stdio = client->stdio;
+        closeClient(client);
+        if (stdio)
+            Q_EMIT finished();
+        return;
+    }
+
+    if (client->in.size() > MaxLineLength)
+        eof = true;
+
+    // The replies not written yet are still sent, then the client is closed
+    if (eof) {
+        client->closing = true;
+        client->readNotifier->setEnabled(false);
+    }
+    writeClient(client);
+}
+
+void MatServer::writeClient(Client *client)
+{
+    bool failed = false;
+    while (!client->out.isEmpty()) {
+        // No SIGPIPE for a client gone away
+        const ssize_t len = client->stdio
+                ? ::write(client->outFd, client->out.constData(), size_t(client->out.size()))
+                : ::send(client->outFd, client->out.constData(), size_t(client->out.size()), MSG_NOSIGNAL);
+        if (len < 0) {
+            if (errno == EINTR)
+                continue;
+            failed = errno != EAGAIN && errno != EWOULDBLOCK;
+            break;
+        }
+        client->out.remove(0, len);
+    }
+
+    if (failed || (client->closing && client->out.isEmpty())) {
+        const bool stdio = client->stdio;
+        closeClient(client);
+        if (stdio)
+            Q_EMIT finished();
+        return;
+    }
+
+    if (client->writeNotifier)
+        client->writeNotifier->setEnabled(!client->out.isEmpty());
+}
+
+void MatServer::closeClient(Client *client)
+{
+    mClients.removeOne(client);
+    if (client->readNotifier) {
+        client->readNotifier->setEnabled(false);
+        client->readNotifier->deleteLater();
+    }
+    if (client->writeNotifier) {
+        client->writeNotifier->setEnabled(false);
+        client->writeNotifier->deleteLater();
+    }
+    if (!client->stdio)
+        ::close(client->inFd);
+    delete client;
+}
+
+QByteArray MatServer::handleRequest(Client *client, const QByteArray &line)
+{
+    const QString request = QString::fromUtf8(line).trimmed();
+    const qsizetype space = request.indexOf(u' ');
+    const QString verb = space < 0 ? request : request.left(space);
+    const QString argument = space < 0 ? QString() : request.mid(space + 1).trimmed();
+
+    QByteArray reply;
+    QString counted = verb;
+    if (verb == "env"_L1) {
+        reply = handleEnv(client, argument);
+    } else if (verb == "defapp"_L1) {
+        QElapsedTimer timer;
+        timer.start();
+        reply = handleDefApp(client, argument);
+        mStats.recordLatency(MatStats::ResolveLatency, timer.nsecsElapsed());
+    } else if (verb == "open"_L1) {
+        reply = handleOpen(client, argument);
+    } else if (verb == "stats"_L1) {
+        reply = "OK " + mStats.summary();
+    } else {
+        reply = "ERR unknown request";
+        counted = u"unknown"_s; // don't let clients grow the counters
+    }
+
+    mStats.countRequest(counted, !reply.startsWith("ERR"));
+    return reply;
+}
+
+QByteArray MatServer::handleEnv(Client *client, const QString &assignment)
+{
+    const qsizetype eq = assignment.indexOf(u'=');
+    const QString key = assignment.left(eq);
+    const QString value = assignment.mid(eq + 1);
+
+    if (key == "XDG_CURRENT_DESKTOP"_L1) {
+        client->desktops = parseDesktops(value);
+        return "OK";
+    }
+
+    if (key != "XDG_CONFIG_HOME"_L1 && key != "XDG_DATA_HOME"_L1)
+        return "ERR unsupported variable";
+
+    if (!client->stdio) {
+        // Only the peer's own directories can be read on its behalf
+        struct stat st;
+        if (!value.startsWith(u'/') || ::stat(QFile::encodeName(value).constData(), &st) != 0
+                || !S_ISDIR(st.st_mode) || st.st_uid != client->uid) {
+            client->envRejected = true;
+            return "ERR not an owned directory";
+        }
+    }
+
+    if (key == "XDG_CONFIG_HOME"_L1)
+        client->configHome = value;
+    else
+        client->dataHome = value;
+    return "OK";
+}
+
+QByteArray MatServer::handleDefApp(Client *client, const QString &mimeType)
+{
+    if (mimeType.isEmpty())
+        return "ERR mimetype missing";
+    if (client->envRejected)
+        return "ERR environment rejected";
+
+    const MatDesktopEntry *app = resolver(client).defaultApp(mimeType);
+    if (app == nullptr)
+        return "NONE";
+    return "OK " + app->id.toUtf8() + '\t' + app->fileName.toUtf8();
+}
+
+QByteArray MatServer::handleOpen(Client *client, const QString &target)
+{
+    // Launching on behalf of another user would run its handler as us
+    if (!client->stdio)
+        return "ERR open is only served on stdin/stdout";
+    if (target.isEmpty())
+        return "ERR file or URL missing";
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QString mimeType;
+    QString launchTarget = target;
+    QUrl launchUrl;
+    const QUrl url(target);
+    const QString scheme = url.scheme();
+    // An existing file named like a URL, e.g. "ab:c", is a file
+    QFileInfo f(launchTarget);
+    if (!f.exists() && scheme == "file"_L1) {
+        launchTarget = url.toLocalFile();
+        f.setFile(launchTarget);
+    }
+    if (f.exists()) {
+        mimeType = mMimeDb.mimeTypeForFile(f).name();
+        launchUrl = QUrl::fromLocalFile(f.absoluteFilePath());
+    } else if (scheme.isEmpty() || scheme == "file"_L1) {
+        return "ERR no such file or directory";
+    } else {
+        mimeType = u"x-scheme-handler/%1"_s.arg(scheme);
+        launchUrl = url;
+    }
+
+    const MatDesktopEntry *app = resolver(client).defaultApp(mimeType);
+    mStats.recordLatency(MatStats::ResolveLatency, timer.nsecsElapsed());
+    if (app == nullptr)
+        return "NONE";
+
+    timer.restart();
+    XdgDesktopFile df;
+    if (!df.load(app->fileName))
+        return "ERR could not load " + app->id.toUtf8();
+
+    bool launched = MatDBusActivation::isActivatable(df)
+            && MatDBusActivation::open(app->id, QList<QUrl>() << launchUrl);
+
+    // Terminal applications need the terminal wrapping of startDetached()
+    if (!launched && mLauncher != nullptr && mLauncher->isRunning() && !df.value(u"Terminal"_s).toBool()) {
+        QString errorMessage;
+        launched = mLauncher->launch(df.expandExecString(QStringList() << launchTarget),
+                                     QProcessEnvironment::systemEnvironment().toStringList(),
+                                     df.value(u"Path"_s).toString(), &errorMessage);
+        if (!launched)
+            qWarning("MatServer: %s", qPrintable(errorMessage));
+    }
+
+    if (!launched)
+        launched = df.startDetached(launchTarget);
+
+    mStats.recordLatency(MatStats::LaunchLatency, timer.nsecsElapsed());
+    if (!launched)
+        return "ERR could not launch " + app->id.toUtf8();
+    return "OK " + app->id.toUtf8();
+}
+
+MatResolver MatServer::resolver(Client *client)
+{
+    UserOverlay *user = overlay(client);
+    SystemLayers *system = systemLayers(client->desktops);
+    return MatResolver(QList<MatMimeAppsLayers *>() << &user->configLayers << &system->configLayers
+                                                    << &user->dataLayers << &system->dataLayers,
+                       QList<MatDesktopDb *>() << &user->db << mSystemDb);
+}
+
+MatServer::UserOverlay *MatServer::overlay(Client *client)
+{
+    const QString key = QString::number(client->uid) + u'\n' + client->configHome + u'\n'
+            + client->dataHome + u'\n' + client->desktops.join(u':');
+
+    UserOverlay *user = mOverlays.value(key);
+    mStats.countCache(u"overlay"_s, user != nullptr);
+    if (user == nullptr) {
+        if (mOverlays.size() >= MaxOverlays) {
+            const auto oldest = std::min_element(mOverlays.begin(), mOverlays.end(),
+                    [](const UserOverlay *a, const UserOverlay *b) { return a->lastUse < b->lastUse; });
+            delete oldest.value();
+            mOverlays.erase(oldest);
+        }
+        user = new UserOverlay(client->configHome, client->dataHome, client->desktops,
+                               client->stdio ? -1 : qint64(client->uid));
+        mOverlays.insert(key, user);
+    } else {
+        user->configLayers.refresh();
+        user->dataLayers.refresh();
+    }
+
+    const QByteArray stamp = treeStamp(client->dataHome + "/applications"_L1);
+    const bool appsFresh = stamp == user->appsStamp;
+    mStats.countCache(u"user-applications"_s, appsFresh);
+    if (!appsFresh) {
+        user->db.reset();
+        user->appsStamp = stamp;
+    }
+
+    user->lastUse = ++mUseCounter;
+    return user;
+}
+
+MatServer::SystemLayers *MatServer::systemLayers(const QStringList &desktops)
+{
+    const QString key = desktops.join(u':');
+    SystemLayers *layers = mSystemLayers.value(key);
+    if (layers == nullptr) {
+        layers = new SystemLayers(desktops);
+        mSystemLayers.insert(key, layers);
+    }
+    return layers;
+}
+
+bool MatServer::query(const QString &socketPath, const QByteArray &request, QByteArray *reply)
+{
+    const QByteArray path = QFile::encodeName(socketPath);
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    if (size_t(path.size()) >= sizeof(addr.sun_path))
+        return false;
+    memcpy(addr.sun_path, path.constData(), size_t(path.size()));
+
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return false;
+
+    const timeval timeout = {1, 0};
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+    if (::connect(fd, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr)) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    QByteArray message;
+    int requests = 0;
+    for (const char *name : {"XDG_CONFIG_HOME", "XDG_DATA_HOME", "XDG_CURRENT_DESKTOP"}) {
+        if (qEnvironmentVariableIsSet(name)) {
+            message += "env " + QByteArray(name) + '=' + qgetenv(name) + '\n';
+            ++requests;
+        }
+    }
+    message += request + '\n';
+    ++requests;
+
+    bool ok = true;
+    for (qsizetype sent = 0; ok && sent < message.size(); ) {
+        const ssize_t len = ::write(fd, message.constData() + sent, size_t(message.size() - sent));
+        ok = len > 0;
+        sent += len;
+    }
+
+    QByteArray in;
+    char buffer[4096];
+    while (ok && in.count('\n') < requests) {
+        const ssize_t len = ::read(fd, buffer, sizeof(buffer));
+        ok = len > 0;
+        if (ok)
+            in.append(buffer, len);
+    }
+    ::close(fd);
+
+    if (!ok)
+        return false;
+
+    // A refused env would be answered from the server's defaults instead
+    const QList<QByteArray> lines = in.split('\n');
+    for (qsizetype i = 0; i < requests - 1; ++i) {
+        if (lines.at(i).startsWith("ERR"))
+            return false;
+    }
+    *reply = lines.at(requests - 1);
+    return true;
+}
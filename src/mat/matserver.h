@@ -0,0 +1,180 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#ifndef MATSERVER_H
+#define MATSERVER_H
+
+#include "matstats.h"
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QMimeDatabase>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+#include <sys/types.h>
+
+class MatDesktopDb;
+class MatLauncher;
+class MatMimeAppsLayers;
+class MatResolver;
+class MatWatcher;
+class QSocketNotifier;
+class QTimer;
+
+/*!
+ * \brief The MatServer class answers resolution requests for many users out
+ * of one copy of the system layers.
+ *
+ * The system mimeapps.list layers and the system desktop database are loaded
+ * once, kept current by a MatWatcher, and shared read-only by every request.
+ * Each user only adds a small overlay: the mimeapps.list files of its
+ * XDG_CONFIG_HOME and XDG_DATA_HOME, and the applications directory of its
+ * XDG_DATA_HOME. Overlays are cached per user and revalidated per request,
+ * with a stat of the layer files and of every file and subdirectory of the
+ * applications directory. The files of a user are read only if that user
+ * owns them, they are regular files, and they aren't oversized.
+ *
+ * The protocol is line based, every request gets exactly one reply line:
+ * \list
+ * \li "env KEY=VALUE" sets XDG_CONFIG_HOME, XDG_DATA_HOME or
+ *     XDG_CURRENT_DESKTOP for the following requests. Replies "OK".
+ * \li "defapp MIMETYPE" replies "OK ID<tab>FILE" or "NONE".
+ * \li "open FILE|URL" launches the default application, stdio mode only.
+ *     Replies "OK ID" or "NONE".
+ * \li "stats" replies "OK" followed by the MatStats::summary() pairs.
+ * \endlist
+ * Errors are replied as "ERR MESSAGE". A client letting more than 1 MiB of
+ * replies pile up is disconnected.
+ *
+ * On a Unix socket the user is the peer of the connection. Its directories
+ * default to the ones under its home and can only be changed to directories
+ * it owns. In stdio (coprocess) mode the user is the server environment.
+ */
+class MatServer : public QObject {
+    Q_OBJECT
+
+public:
+    /*!
+     * \brief MatServer
+     * \param parent
+     */
+    explicit MatServer(QObject *parent = nullptr);
+
+    /*!
+     * \brief ~MatServer
+     */
+    ~MatServer() override;
+
+    /*!
+     * \brief listen Serves the clients of a Unix socket
+     * \param socketPath
+     * \param errorMessage
+     * \return false on error
+     */
+    bool listen(const QString &socketPath, QString *errorMessage);
+
+    /*!
+     * \brief serveStdio Serves requests from stdin, replying on stdout
+     */
+    void serveStdio();
+
+    /*!
+     * \brief setLauncher Runs the "open" launches through \a launcher
+     * \param launcher A started launcher, not owned
+     */
+    inline void setLauncher(MatLauncher *launcher) { mLauncher = launcher; }
+
+    /*!
+     * \brief setMetricsFile Writes the Prometheus metrics to \a fileName
+     * every ten seconds and on exit
+     * \param fileName
+     */
+    void setMetricsFile(const QString &fileName);
+
+    /*!
+     * \brief listenMetrics Sends the Prometheus metrics to every client of
+     * a Unix socket, then closes the connection
+     * \param socketPath
+     * \param errorMessage
+     * \return false on error
+     */
+    bool listenMetrics(const QString &socketPath, QString *errorMessage);
+
+    /*!
+     * \brief stats
+     * \return
+     */
+    inline const MatStats &stats() const { return mStats; }
+
+    /*!
+     * \brief query Sends one request to a server, forwarding the XDG
+     * environment of the calling process first
+     * \param socketPath
+     * \param request The request line, without the line feed
+     * \param reply The reply line, without the line feed
+     * \return false if the server couldn't be reached or refused part of the
+     * environment, the caller must then resolve by itself
+     */
+    static bool query(const QString &socketPath, const QByteArray &request, QByteArray *reply);
+
+Q_SIGNALS:
+    void finished();
+
+private:
+    struct Client;
+    struct UserOverlay;
+    struct SystemLayers;
+
+    void acceptClients();
+    void acceptMetricsClients();
+    void writeMetricsFile();
+    void readClient(Client *client);
+    void writeClient(Client *client);
+    void closeClient(Client *client);
+    QByteArray handleRequest(Client *client, const QByteArray &line);
+    QByteArray handleEnv(Client *client, const QString &assignment);
+    QByteArray handleDefApp(Client *client, const QString &mimeType);
+    QByteArray handleOpen(Client *client, const QString &target);
+    MatResolver resolver(Client *client);
+    UserOverlay *overlay(Client *client);
+    SystemLayers *systemLayers(const QStringList &desktops);
+
+    int mListenFd;
+    QString mSocketPath;
+    QSocketNotifier *mListenNotifier;
+    int mMetricsFd;
+    QString mMetricsSocketPath;
+    QString mMetricsFile;
+    QTimer *mMetricsTimer;
+    MatStats mStats;
+    QMimeDatabase mMimeDb;
+    MatLauncher *mLauncher;
+    QList<Client *> mClients;
+    MatDesktopDb *mSystemDb;
+    QHash<QString, SystemLayers *> mSystemLayers;
+    QHash<QString, UserOverlay *> mOverlays;
+    MatWatcher *mWatcher;
+    quint64 mUseCounter;
+};
+
+#endif // MATSERVER_H
@@ -0,0 +1,220 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "matsnapshot.h"
+
+#include "matdesktopdb.h"
+#include "matmimeappslist.h"
+#include "matmimeappswriter.h"
+#include "xdgdesktopfile.h"
+#include "xdgmimeapps.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QSet>
+
+#include <algorithm>
+#include <cstdio>
+
+using namespace Qt::Literals::StringLiterals;
+
+static constexpr int SnapshotVersion = 2;
+
+MatSnapshot::Table MatSnapshot::live()
+{
+    MatMimeAppsLayers layers;
+    MatDesktopDb db;
+
+    QSet<QString> mimeTypes;
+    const QList<const MatMimeAppsList *> lists = layers.layers();
+    for (const MatMimeAppsList *list : lists) {
+        for (int group = MatMimeAppsList::DefaultApplications; group <= MatMimeAppsList::AddedAssociations; ++group) {
+            const QHash<QString, QStringList> &entries = list->entries(static_cast<MatMimeAppsList::Group>(group));
+            for (auto it = entries.cbegin(); it != entries.cend(); ++it)
+                mimeTypes.insert(it.key());
+        }
+    }
+    const QList<const MatDesktopEntry *> entries = db.entries();
+    for (const MatDesktopEntry *entry : entries) {
+        for (const QString &mimeType : entry->mimeTypes)
+            mimeTypes.insert(mimeType);
+    }
+
+    QStringList sorted(mimeTypes.cbegin(), mimeTypes.cend());
+    std::sort(sorted.begin(), sorted.end());
+
+    // Resolved like defapp does, mimetype parents, aliases and TryExec included
+    XdgMimeApps apps;
+    Table table;
+    table.reserve(sorted.size());
+    for (const QString &mimeType : std::as_const(sorted)) {
+        if (XdgDesktopFile *app = apps.defaultApp(mimeType)) {
+            table.append(qMakePair(mimeType, XdgDesktopFile::id(app->fileName())));
+            delete app;
+        }
+    }
+    return table;
+}
+
+MatSnapshot::Associations MatSnapshot::associations(const MatMimeAppsList &list)
+{
+    Associations associations;
+    for (int group = MatMimeAppsList::DefaultApplications; group <= MatMimeAppsList::RemovedAssociations; ++group) {
+        const QHash<QString, QStringList> &entries = list.entries(static_cast<MatMimeAppsList::Group>(group));
+        for (auto it = entries.cbegin(); it != entries.cend(); ++it) {
+            if (!it.value().isEmpty())
+                associations.insert(qMakePair(group, it.key()), it.value());
+        }
+    }
+    return associations;
+}
+
+MatSnapshot::Associations MatSnapshot::userLive()
+{
+    MatMimeAppsList list(MatMimeAppsWriter::defaultFileName());
+    list.load();
+    return associations(list);
+}
+
+bool MatSnapshot::load(const QString &fileName, Table *table, QString *errorMessage, Associations *user)
+{
+    QFile file;
+    bool opened;
+    if (fileName == "-"_L1) {
+        opened = file.open(stdin, QIODevice::ReadOnly);
+    } else {
+        file.setFileName(fileName);
+        opened = file.open(QIODevice::ReadOnly);
+    }
+    if (!opened) {
+        *errorMessage = u"Could not read %1: %2"_s.arg(fileName, file.errorString());
+        return false;
+    }
+
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+    if (doc.isNull()) {
+        *errorMessage = u"%1 is not a snapshot: %2"_s.arg(fileName, error.errorString());
+        return false;
+    }
+
+    const QJsonObject root = doc.object();
+    const int version = root.value("version"_L1).toInt();
+    if (version < 1 || version > SnapshotVersion || !root.value("defaults"_L1).isObject()) {
+        *errorMessage = u"%1 is not a version 1 to %2 snapshot"_s.arg(fileName).arg(SnapshotVersion);
+        return false;
+    }
+    if (user != nullptr && (version < 2 || !root.value("user"_L1).isObject())) {
+        *errorMessage = u"%1 doesn't have the user associations, take a new snapshot"_s.arg(fileName);
+        return false;
+    }
+
+    const QJsonObject defaults = root.value("defaults"_L1).toObject();
+    table->clear();
+    table->reserve(defaults.size());
+    for (auto it = defaults.constBegin(); it != defaults.constEnd(); ++it) {
+        const QString id = it.value().toString();
+        if (!id.isEmpty())
+            table->append(qMakePair(it.key(), id));
+    }
+    // QJsonObject already iterates in key order, this is just a check
+    if (!std::is_sorted(table->cbegin(), table->cend()))
+        std::sort(table->begin(), table->end());
+
+    if (user != nullptr) {
+        const QJsonObject groups = root.value("user"_L1).toObject();
+        user->clear();
+        for (int group = MatMimeAppsList::DefaultApplications; group <= MatMimeAppsList::RemovedAssociations; ++group) {
+            const QJsonObject entries = groups.value(MatMimeAppsList::groupName(static_cast<MatMimeAppsList::Group>(group))).toObject();
+            for (auto it = entries.constBegin(); it != entries.constEnd(); ++it) {
+                QStringList ids;
+                const QJsonArray values = it.value().toArray();
+                for (const QJsonValue &value : values) {
+                    if (!value.toString().isEmpty())
+                        ids.append(value.toString());
+                }
+                if (!ids.isEmpty())
+                    user->insert(qMakePair(group, it.key()), ids);
+            }
+        }
+    }
+    return true;
+}
+
+bool MatSnapshot::save(const Table &table, const Associations &user, const QString &fileName, QString *errorMessage)
+{
+    QJsonObject defaults;
+    for (const auto &row : table)
+        defaults.insert(row.first, row.second);
+
+    QJsonObject groups[3];
+    for (auto it = user.cbegin(); it != user.cend(); ++it)
+        groups[it.key().first].insert(it.key().second, QJsonArray::fromStringList(it.value()));
+    QJsonObject userGroups;
+    for (int group = MatMimeAppsList::DefaultApplications; group <= MatMimeAppsList::RemovedAssociations; ++group)
+        userGroups.insert(MatMimeAppsList::groupName(static_cast<MatMimeAppsList::Group>(group)), groups[group]);
+
+    QJsonObject root;
+    root.insert("version"_L1, SnapshotVersion);
+    root.insert("defaults"_L1, defaults);
+    root.insert("user"_L1, userGroups);
+    const QByteArray data = QJsonDocument(root).toJson(QJsonDocument::Compact) + '\n';
+
+    if (fileName == "-"_L1) {
+        QFile out;
+        if (!out.open(stdout, QIODevice::WriteOnly) || out.write(data) != data.size()) {
+            *errorMessage = u"Could not write the snapshot: %1"_s.arg(out.errorString());
+            return false;
+        }
+        return true;
+    }
+
+    QSaveFile out(fileName);
+    if (!out.open(QIODevice::WriteOnly) || out.write(data) != data.size() || !out.commit()) {
+        *errorMessage = u"Could not write %1: %2"_s.arg(fileName, out.errorString());
+        return false;
+    }
+    return true;
+}
+
+QList<MatSnapshot::Change> MatSnapshot::diff(const Table &from, const Table &to)
+{
+    QList<Change> changes;
+    qsizetype i = 0;
+    qsizetype j = 0;
+    while (i < from.size() || j < to.size()) {
+        if (j == to.size() || (i < from.size() && from.at(i).first < to.at(j).first)) {
+            changes.append(Change{from.at(i).first, from.at(i).second, QString()});
+            ++i;
+        } else if (i == from.size() || to.at(j).first < from.at(i).first) {
+            changes.append(Change{to.at(j).first, QString(), to.at(j).second});
+            ++j;
+        } else {
+            if (from.at(i).second != to.at(j).second)
+                changes.append(Change{from.at(i).first, from.at(i).second, to.at(j).second});
+            ++i;
+            ++j;
+        }
+    }
+    return changes;
+}
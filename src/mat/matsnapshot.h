@@ -0,0 +1,114 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#ifndef MATSNAPSHOT_H
+#define MATSNAPSHOT_H
+
+#include <QList>
+#include <QMap>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+
+class MatMimeAppsList;
+
+/*!
+ * \brief The MatSnapshot class captures the effective default application of
+ * every mimetype.
+ *
+ * A snapshot is a table sorted by mimetype, stored as compact JSON:
+ * {"version":2,"defaults":{"mimetype":"desktop id",...},"user":{...}}. Being
+ * sorted, two snapshots compare in one linear pass.
+ *
+ * The effective defaults also come from the system layers, mimetype parents
+ * and aliases, and the installed applications, none of which restore can
+ * write. So "user" keeps the explicit associations of the user's
+ * mimeapps.list, by group: {"Default Applications":{"mimetype":["id",...]},
+ * ...}. That is what restore compares and writes back. Version 1 snapshots
+ * lack it, they can only be compared.
+ */
+class MatSnapshot {
+
+public:
+    using Table = QList<QPair<QString, QString>>; //!< (mimetype, desktop id)
+
+    //! The entries of one mimeapps.list, (group, mimetype) to desktop ids
+    using Associations = QMap<QPair<int, QString>, QStringList>;
+
+    struct Change {
+        QString mimeType;
+        QString oldId; //!< Empty if the mimetype had no default
+        QString newId; //!< Empty if the mimetype has no default anymore
+    };
+
+    /*!
+     * \brief live
+     *
+     * Every mimetype named in a mimeapps.list layer or by an installed
+     * application is resolved through XdgMimeApps, as defapp does.
+     * \return The current defaults
+     */
+    static Table live();
+
+    /*!
+     * \brief associations
+     * \param list
+     * \return The explicit entries of \a list, every group
+     */
+    static Associations associations(const MatMimeAppsList &list);
+
+    /*!
+     * \brief userLive
+     * \return The associations of the user's mimeapps.list, the one
+     * MatMimeAppsWriter writes by default
+     */
+    static Associations userLive();
+
+    /*!
+     * \brief load
+     * \param fileName A snapshot file, "-" for the standard input
+     * \param table
+     * \param errorMessage
+     * \param user Set to the user's associations, nullptr not to need them
+     * \return false if \a fileName can't be read or isn't a snapshot, or
+     * if \a user is given and it's a version 1 snapshot
+     */
+    static bool load(const QString &fileName, Table *table, QString *errorMessage, Associations *user = nullptr);
+
+    /*!
+     * \brief save
+     * \param table
+     * \param user
+     * \param fileName The snapshot file, "-" for the standard output
+     * \param errorMessage
+     * \return false if \a fileName can't be written
+     */
+    static bool save(const Table &table, const Associations &user, const QString &fileName, QString *errorMessage);
+
+    /*!
+     * \brief diff
+     * \param from
+     * \param to
+     * \return The changes from \a from to \a to, sorted by mimetype
+     */
+    static QList<Change> diff(const Table &from, const Table &to);
+};
+
+#endif // MATSNAPSHOT_H
@@ -0,0 +1,160 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "matstats.h"
+
+#include <QSaveFile>
+
+static const char *const latencyNames[MatStats::LatencyCount] = {
+    "resolve",
+    "launch"
+};
+
+void MatHistogram::record(qint64 nsecs)
+{
+    const quint64 usecs = nsecs > 0 ? quint64(nsecs) / 1000 : 0;
+    // bucket i holds (2^(i-1), 2^i] microseconds
+    const int bucket = usecs <= 1 ? 0 : 64 - __builtin_clzll(usecs - 1);
+    ++mBuckets[qMin(bucket, BucketCount - 1)];
+    ++mCount;
+    mSumNsecs += quint64(qMax<qint64>(nsecs, 0));
+}
+
+double MatHistogram::percentile(double q) const
+{
+    if (mCount == 0)
+        return 0.0;
+
+    const quint64 rank = qMax<quint64>(1, quint64(q * double(mCount) + 0.5));
+    quint64 seen = 0;
+    for (int i = 0; i < BucketCount; ++i) {
+        seen += mBuckets[i];
+        if (seen >= rank)
+            return bucketBound(i);
+    }
+    return bucketBound(BucketCount - 1);
+}
+
+double MatHistogram::bucketBound(int bucket)
+{
+    return double(quint64(1) << bucket) / 1e6;
+}
+
+void MatStats::countRequest(const QString &command, bool success)
+{
+    CommandCounters &counters = mCommands[command];
+    ++counters.requests;
+    if (!success)
+        ++counters.errors;
+}
+
+void MatStats::countCache(const QString &cache, bool hit)
+{
+    CacheCounters &counters = mCaches[cache];
+    if (hit)
+        ++counters.hits;
+    else
+        ++counters.misses;
+}
+
+void MatStats::recordLatency(Latency latency, qint64 nsecs)
+{
+    mLatencies[latency].record(nsecs);
+}
+
+QByteArray MatStats::summary() const
+{
+    QByteArray text;
+    for (auto it = mCommands.cbegin(); it != mCommands.cend(); ++it) {
+        const QByteArray command = it.key().toUtf8();
+        text += "requests." + command + '=' + QByteArray::number(it->requests) + ' ';
+        text += "errors." + command + '=' + QByteArray::number(it->errors) + ' ';
+    }
+    for (auto it = mCaches.cbegin(); it != mCaches.cend(); ++it) {
+        const QByteArray cache = it.key().toUtf8();
+        const quint64 total = it->hits + it->misses;
+        text += "cache." + cache + ".hits=" + QByteArray::number(it->hits) + ' ';
+        text += "cache." + cache + ".misses=" + QByteArray::number(it->misses) + ' ';
+        text += "cache." + cache + ".ratio="
+                + QByteArray::number(total ? double(it->hits) / double(total) : 0.0, 'f', 3) + ' ';
+    }
+    for (int i = 0; i < LatencyCount; ++i) {
+        const MatHistogram &h = mLatencies[i];
+        const QByteArray name = latencyNames[i];
+        text += name + ".count=" + QByteArray::number(h.count()) + ' ';
+        text += name + ".p50=" + QByteArray::number(h.percentile(0.50), 'g', 6) + ' ';
+        text += name + ".p95=" + QByteArray::number(h.percentile(0.95), 'g', 6) + ' ';
+        text += name + ".p99=" + QByteArray::number(h.percentile(0.99), 'g', 6) + ' ';
+    }
+    text.chop(1);
+    return text;
+}
+
+QByteArray MatStats::prometheus() const
+{
+    QByteArray text;
+
+    text += "# HELP qtxdg_mat_requests_total Requests served, per command.\n"
+            "# TYPE qtxdg_mat_requests_total counter\n";
+    for (auto it = mCommands.cbegin(); it != mCommands.cend(); ++it)
+        text += "qtxdg_mat_requests_total{command=\"" + it.key().toUtf8() + "\"} " + QByteArray::number(it->requests) + '\n';
+
+    text += "# HELP qtxdg_mat_errors_total Failed requests, per command.\n"
+            "# TYPE qtxdg_mat_errors_total counter\n";
+    for (auto it = mCommands.cbegin(); it != mCommands.cend(); ++it)
+        text += "qtxdg_mat_errors_total{command=\"" + it.key().toUtf8() + "\"} " + QByteArray::number(it->errors) + '\n';
+
+    text += "# HELP qtxdg_mat_cache_hits_total Cache hits, per cache.\n"
+            "# TYPE qtxdg_mat_cache_hits_total counter\n";
+    for (auto it = mCaches.cbegin(); it != mCaches.cend(); ++it)
+        text += "qtxdg_mat_cache_hits_total{cache=\"" + it.key().toUtf8() + "\"} " + QByteArray::number(it->hits) + '\n';
+
+    text += "# HELP qtxdg_mat_cache_misses_total Cache misses, per cache.\n"
+            "# TYPE qtxdg_mat_cache_misses_total counter\n";
+    for (auto it = mCaches.cbegin(); it != mCaches.cend(); ++it)
+        text += "qtxdg_mat_cache_misses_total{cache=\"" + it.key().toUtf8() + "\"} " + QByteArray::number(it->misses) + '\n';
+
+    for (int i = 0; i < LatencyCount; ++i) {
+        const MatHistogram &h = mLatencies[i];
+        const QByteArray name = "qtxdg_mat_" + QByteArray(latencyNames[i]) + "_seconds";
+        text += "# HELP " + name + " Latency of the " + latencyNames[i] + " step.\n";
+        text += "# TYPE " + name + " histogram\n";
+        quint64 cumulative = 0;
+        for (int b = 0; b < MatHistogram::BucketCount; ++b) {
+            cumulative += h.bucket(b);
+            text += name + "_bucket{le=\"" + QByteArray::number(MatHistogram::bucketBound(b), 'g', 6) + "\"} "
+                    + QByteArray::number(cumulative) + '\n';
+        }
+        text += name + "_bucket{le=\"+Inf\"} " + QByteArray::number(h.count()) + '\n';
+        text += name + "_sum " + QByteArray::number(h.sum(), 'g', 9) + '\n';
+        text += name + "_count " + QByteArray::number(h.count()) + '\n';
+    }
+
+    return text;
+}
+
+bool MatStats::writePrometheus(const QString &fileName) const
+{
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    file.write(prometheus());
+    return file.commit();
+}
@@ -0,0 +1,156 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#ifndef MATSTATS_H
+#define MATSTATS_H
+
+#include <QByteArray>
+#include <QMap>
+#include <QString>
+
+#include <array>
+
+/*!
+ * \brief The MatHistogram class is a latency histogram with power of two
+ * buckets, from 1 microsecond to about half an hour.
+ *
+ * Recording is a couple of integer operations. Percentiles are reported as
+ * the upper bound of the bucket they fall in.
+ */
+class MatHistogram {
+
+public:
+    static constexpr int BucketCount = 32;
+
+    /*!
+     * \brief record
+     * \param nsecs The latency, in nanoseconds
+     */
+    void record(qint64 nsecs);
+
+    /*!
+     * \brief count
+     * \return
+     */
+    inline quint64 count() const { return mCount; }
+
+    /*!
+     * \brief percentile
+     * \param q In [0, 1]
+     * \return The latency, in seconds
+     */
+    double percentile(double q) const;
+
+    /*!
+     * \brief bucketBound
+     * \param bucket
+     * \return The upper bound of \a bucket, in seconds
+     */
+    static double bucketBound(int bucket);
+
+    /*!
+     * \brief bucket
+     * \param bucket
+     * \return The number of samples in \a bucket
+     */
+    inline quint64 bucket(int bucket) const { return mBuckets[bucket]; }
+
+    /*!
+     * \brief sum
+     * \return The sum of all the samples, in seconds
+     */
+    inline double sum() const { return double(mSumNsecs) / 1e9; }
+
+private:
+    std::array<quint64, BucketCount> mBuckets = {};
+    quint64 mCount = 0;
+    quint64 mSumNsecs = 0;
+};
+
+/*!
+ * \brief The MatStats class collects the counters of the long-running modes.
+ */
+class MatStats {
+
+public:
+    enum Latency {
+        ResolveLatency,
+        LaunchLatency,
+        LatencyCount
+    };
+
+    /*!
+     * \brief countRequest
+     * \param command
+     * \param success
+     */
+    void countRequest(const QString &command, bool success);
+
+    /*!
+     * \brief countCache
+     * \param cache
+     * \param hit
+     */
+    void countCache(const QString &cache, bool hit);
+
+    /*!
+     * \brief recordLatency
+     * \param latency
+     * \param nsecs
+     */
+    void recordLatency(Latency latency, qint64 nsecs);
+
+    /*!
+     * \brief summary
+     * \return The counters and the p50/p95/p99 latencies as space separated
+     * key=value pairs, on one line
+     */
+    QByteArray summary() const;
+
+    /*!
+     * \brief prometheus
+     * \return The Prometheus text exposition format of all the counters
+     */
+    QByteArray prometheus() const;
+
+    /*!
+     * \brief writePrometheus Atomically replaces \a fileName with prometheus()
+     * \param fileName
+     * \return false on error
+     */
+    bool writePrometheus(const QString &fileName) const;
+
+private:
+    struct CacheCounters {
+        quint64 hits = 0;
+        quint64 misses = 0;
+    };
+
+    struct CommandCounters {
+        quint64 requests = 0;
+        quint64 errors = 0;
+    };
+
+    QMap<QString, CommandCounters> mCommands;
+    QMap<QString, CacheCounters> mCaches;
+    std::array<MatHistogram, LatencyCount> mLatencies;
+};
+
+#endif // MATSTATS_H
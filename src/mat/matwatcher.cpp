@@ -0,0 +1,258 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "matwatcher.h"
+
+#include "matdesktopdb.h"
+#include "matmimeappslist.h"
+#include "xdgdirs.h"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QSocketNotifier>
+#include <QTimer>
+
+#include <sys/inotify.h>
+#include <unistd.h>
+
+using namespace Qt::Literals::StringLiterals;
+
+static constexpr quint32 WatchMask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE
+                                   | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+
+// Long enough to merge the events of a package transaction
+static constexpr int ChangedDelay = 200;
+
+MatWatcher::MatWatcher(QObject *parent)
+    : QObject(parent),
+      mFd(inotify_init1(IN_NONBLOCK | IN_CLOEXEC)),
+      mNotifier(nullptr),
+      mChangedTimer(new QTimer(this)),
+      mDesktopDb(nullptr),
+      mMimeAppsLayers(nullptr)
+{
+    mChangedTimer->setSingleShot(true);
+    mChangedTimer->setInterval(ChangedDelay);
+    connect(mChangedTimer, &QTimer::timeout, this, &MatWatcher::changed);
+
+    if (mFd < 0) {
+        qWarning("MatWatcher: inotify_init1 failed");
+        return;
+    }
+
+    mNotifier = new QSocketNotifier(mFd, QSocketNotifier::Read, this);
+    connect(mNotifier, &QSocketNotifier::activated, this, &MatWatcher::readEvents);
+}
+
+MatWatcher::~MatWatcher()
+{
+    if (mFd >= 0)
+        ::close(mFd);
+}
+
+void MatWatcher::watchDefaultDirs()
+{
+    watchDir(XdgDirs::configHome(false), MimeAppsDir);
+    const QStringList configDirs = XdgDirs::configDirs();
+    for (const QString &dir : configDirs)
+        watchDir(dir, MimeAppsDir);
+
+    // the applications dirs also hold mimeapps.list layers
+    const QStringList applicationsDirs = MatDesktopDb::applicationsDirs();
+    for (const QString &dir : applicationsDirs)
+        watchDir(dir, ApplicationsDir);
+
+    watchDir(XdgDirs::dataHome(false) + "/mime"_L1, MimeDir);
+    const QStringList dataDirs = XdgDirs::dataDirs();
+    for (const QString &dir : dataDirs)
+        watchDir(dir + "/mime"_L1, MimeDir);
+}
+
+void MatWatcher::watchDir(const QString &dir, DirKind kind)
+{
+    if (!isValid())
+        return;
+
+    const QString path = QDir::cleanPath(dir);
+    if (QFileInfo(path).isDir()) {
+        mPending.remove(path);
+        if (!addWatch(path, kind, false))
+            return;
+
+        if (kind == ApplicationsDir) {
+            QDirIterator it(path, QDir::Dirs | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+            while (it.hasNext())
+                addWatch(it.next(), kind, false);
+        }
+        return;
+    }
+
+    // Wait for it to be created
+    mPending.insert(path, kind);
+    QString ancestor = QFileInfo(path).path();
+    while (!QFileInfo(ancestor).isDir() && ancestor != "/"_L1)
+        ancestor = QFileInfo(ancestor).path();
+    addWatch(ancestor, kind, true);
+}
+
+void MatWatcher::watchFile(const QString &fileName)
+{
+    const QString path = QDir::cleanPath(fileName);
+    mFiles.insert(path);
+    watchDir(QFileInfo(path).path(), MimeAppsDir);
+}
+
+bool MatWatcher::addWatch(const QString &dir, DirKind kind, bool ancestorOnly)
+{
+    const int wd = inotify_add_watch(mFd, QFile::encodeName(dir).constData(), WatchMask);
+    if (wd < 0)
+        return false;
+
+    const auto it = mWatches.constFind(wd);
+    if (it != mWatches.constEnd() && !it->ancestorOnly)
+        return true; // already a real watch
+
+    Watch watch;
+    watch.path = dir;
+    watch.kind = kind;
+    watch.ancestorOnly = ancestorOnly;
+    mWatches.insert(wd, watch);
+    return true;
+}
+
+void MatWatcher::readEvents()
+{
+    alignas(inotify_event) char buffer[16 * 1024];
+
+    for (;;) {
+        const ssize_t len = ::read(mFd, buffer, sizeof(buffer));
+        if (len <= 0)
+            break;
+
+        for (char *p = buffer; p < buffer + len; ) {
+            const auto *event = reinterpret_cast<const inotify_event *>(p);
+            p += sizeof(inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                invalidateAll();
+                continue;
+            }
+
+            const auto it = mWatches.constFind(event->wd);
+            if (it == mWatches.constEnd())
+                continue;
+
+            if (event->mask & IN_IGNORED) { // the directory is gone
+                const Watch watch = it.value();
+                mWatches.remove(event->wd);
+                if (!watch.ancestorOnly)
+                    watchDir(watch.path, watch.kind);
+                continue;
+            }
+
+            const QString name = event->len ? QFile::decodeName(event->name) : QString();
+            handleEvent(it.value(), event->mask, name);
+        }
+    }
+}
+
+void MatWatcher::handleEvent(const Watch &watch, quint32 mask, const QString &name)
+{
+    if (name.isEmpty())
+        return;
+
+    const QString path = watch.path + u'/' + name;
+
+    if (mask & IN_ISDIR) {
+        if (!(mask & (IN_CREATE | IN_MOVED_TO)))
+            return;
+
+        // A pending directory, or one of its ancestors, showed up
+        const QList<QString> pending = mPending.keys();
+        for (const QString &dir : pending) {
+            if (dir == path || dir.startsWith(path + u'/')) {
+                const DirKind kind = mPending.value(dir);
+                watchDir(dir, kind);
+                if (dir == path) {
+                    const QStringList files = QDir(path).entryList(QDir::Files);
+                    for (const QString &file : files)
+                        handleFile(kind, path + u'/' + file);
+                }
+            }
+        }
+
+        // A new subdirectory of the applications, possibly full of files
+        if (!watch.ancestorOnly && watch.kind == ApplicationsDir) {
+            watchDir(path, ApplicationsDir);
+            QDirIterator it(path, QStringList() << u"*.desktop"_s, QDir::Files, QDirIterator::Subdirectories);
+            while (it.hasNext())
+                handleFile(ApplicationsDir, it.next());
+        }
+        return;
+    }
+
+    if (!watch.ancestorOnly)
+        handleFile(watch.kind, path);
+}
+
+void MatWatcher::handleFile(DirKind kind, const QString &fileName)
+{
+    if (mFiles.contains(fileName)) {
+        Q_EMIT fileChanged(fileName);
+        mChangedTimer->start();
+        return;
+    }
+
+    if (fileName.endsWith("mimeapps.list"_L1)) {
+        if (kind != MimeAppsDir && kind != ApplicationsDir)
+            return;
+        if (mMimeAppsLayers)
+            mMimeAppsLayers->invalidate(fileName);
+        Q_EMIT mimeAppsListChanged(fileName);
+    } else if (fileName.endsWith(".desktop"_L1)) {
+        if (kind != ApplicationsDir)
+            return;
+        if (mDesktopDb)
+            mDesktopDb->invalidateFile(fileName);
+        Q_EMIT desktopFileChanged(fileName);
+    } else if (kind == MimeDir && fileName.endsWith("/mime.cache"_L1)) {
+        Q_EMIT mimeDatabaseChanged();
+    } else {
+        return;
+    }
+
+    mChangedTimer->start();
+}
+
+void MatWatcher::invalidateAll()
+{
+    if (mMimeAppsLayers) {
+        const QStringList files = mMimeAppsLayers->fileNames();
+        for (const QString &file : files)
+            mMimeAppsLayers->invalidate(file);
+    }
+    if (mDesktopDb)
+        mDesktopDb->reset();
+
+    Q_EMIT mimeDatabaseChanged();
+    mChangedTimer->start();
+}
@@ -0,0 +1,135 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#ifndef MATWATCHER_H
+#define MATWATCHER_H
+
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+class MatDesktopDb;
+class MatMimeAppsLayers;
+class QSocketNotifier;
+class QTimer;
+
+/*!
+ * \brief The MatWatcher class watches, through inotify, the files that the
+ * default application resolution depends on.
+ *
+ * Those are the mimeapps.list layers, the applications directories and the
+ * shared-mime-info caches. Every change is reported for the single file that
+ * changed, and the attached caches drop just that entry. changed() is
+ * emitted once per burst of events, so a package update touching thousands
+ * of files costs one notification.
+ */
+class MatWatcher : public QObject {
+    Q_OBJECT
+
+public:
+    enum DirKind {
+        MimeAppsDir,     //!< Holds mimeapps.list layers
+        ApplicationsDir, //!< Holds desktop files, watched recursively
+        MimeDir          //!< Holds the shared-mime-info caches
+    };
+
+    /*!
+     * \brief MatWatcher
+     * \param parent
+     */
+    explicit MatWatcher(QObject *parent = nullptr);
+
+    /*!
+     * \brief ~MatWatcher
+     */
+    ~MatWatcher() override;
+
+    /*!
+     * \brief isValid
+     * \return false if inotify isn't available
+     */
+    inline bool isValid() const { return mFd >= 0; }
+
+    /*!
+     * \brief setDesktopDb Invalidates \a db entries on desktop file changes
+     * \param db
+     */
+    inline void setDesktopDb(MatDesktopDb *db) { mDesktopDb = db; }
+
+    /*!
+     * \brief setMimeAppsLayers Invalidates \a layers on mimeapps.list changes
+     * \param layers
+     */
+    inline void setMimeAppsLayers(MatMimeAppsLayers *layers) { mMimeAppsLayers = layers; }
+
+    /*!
+     * \brief watchDefaultDirs Watches the directories of the current environment
+     */
+    void watchDefaultDirs();
+
+    /*!
+     * \brief watchDir
+     * \param dir The directory to watch. If it doesn't exist yet, its nearest
+     * existing ancestor is watched until it gets created.
+     * \param kind What \a dir holds
+     */
+    void watchDir(const QString &dir, DirKind kind);
+
+    /*!
+     * \brief watchFile Watches one more file, e.g. a configuration file
+     * \param fileName
+     */
+    void watchFile(const QString &fileName);
+
+Q_SIGNALS:
+    void mimeAppsListChanged(const QString &fileName);
+    void desktopFileChanged(const QString &fileName);
+    void mimeDatabaseChanged();
+    void fileChanged(const QString &fileName);
+    void changed();
+
+private Q_SLOTS:
+    void readEvents();
+
+private:
+    struct Watch {
+        QString path;
+        DirKind kind = MimeAppsDir;
+        bool ancestorOnly = false; //!< Only watched for a pending directory
+    };
+
+    bool addWatch(const QString &dir, DirKind kind, bool ancestorOnly);
+    void handleEvent(const Watch &watch, quint32 mask, const QString &name);
+    void handleFile(DirKind kind, const QString &fileName);
+    void invalidateAll();
+
+    int mFd;
+    QSocketNotifier *mNotifier;
+    QTimer *mChangedTimer;
+    QHash<int, Watch> mWatches;
+    QHash<QString, DirKind> mPending; // missing directories
+    QSet<QString> mFiles; // watchFile()
+    MatDesktopDb *mDesktopDb;
+    MatMimeAppsLayers *mMimeAppsLayers;
+};
+
+#endif // MATWATCHER_H
@@ -0,0 +1,167 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "mimeinfomatcommand.h"
+
+#include "matglobals.h"
+#include "matlinereader.h"
+#include "matmimeinfo.h"
+
+#include <QCommandLineOption>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QString>
+#include <QStringList>
+
+#include <iostream>
+
+using namespace Qt::Literals::StringLiterals;
+
+struct MimeInfoData {
+    MimeInfoData() : format(MatOutput::TextFormat), readStdin(false), nulSeparated(false) {}
+
+    MatOutput::Format format;
+    bool readStdin;
+    bool nulSeparated;
+    QStringList mimeTypes;
+};
+
+static CommandLineParseResult parseCommandLine(QCommandLineParser *parser, MimeInfoData *data, QString *errorMessage)
+{
+    parser->clearPositionalArguments();
+    parser->setApplicationDescription(u"Get the comment, icons and parents of mimetypes"_s);
+
+    parser->addPositionalArgument(u"mimeinfo"_s, u"mimetypes"_s,
+                                  QCoreApplication::tr("[mimetype...]"));
+
+    const QCommandLineOption stdinOption(QStringList() << u"stdin"_s,
+                u"Also read mimetypes from the standard input, one per line"_s);
+    const QCommandLineOption nulOption(QStringList() << u"z"_s << u"null"_s,
+                u"With --stdin, the mimetypes are NUL terminated"_s);
+
+    const QCommandLineOption formatOption = MatOutput::formatOption();
+    parser->addOption(stdinOption);
+    parser->addOption(nulOption);
+    parser->addOption(formatOption);
+    const QCommandLineOption helpOption = parser->addHelpOption();
+    const QCommandLineOption versionOption = parser->addVersionOption();
+
+    if (!parser->parse(QCoreApplication::arguments())) {
+        *errorMessage = parser->errorText();
+        return CommandLineError;
+    }
+
+    if (parser->isSet(versionOption)) {
+        return CommandLineVersionRequested;
+    }
+
+    if (parser->isSet(helpOption) || parser->isSet(u"help-all"_s)) {
+        return CommandLineHelpRequested;
+    }
+
+    if (!MatOutput::formatFromName(parser->value(formatOption), &data->format)) {
+        *errorMessage = u"Unknown output format: "_s + parser->value(formatOption);
+        return CommandLineError;
+    }
+
+    QStringList posArgs = parser->positionalArguments();
+    posArgs.removeAt(0);
+
+    data->readStdin = parser->isSet(stdinOption);
+    data->nulSeparated = parser->isSet(nulOption);
+    if (posArgs.isEmpty() && !data->readStdin) {
+        *errorMessage = u"MimeType missing"_s;
+        return CommandLineError;
+    }
+
+    data->mimeTypes = posArgs;
+
+    return CommandLineOk;
+}
+
+MimeInfoMatCommand::MimeInfoMatCommand(QCommandLineParser *parser)
+    : MatCommandInterface(u"mimeinfo"_s,
+                          u"Get the comment, icons and parents of mimetypes"_s,
+                          parser)
+{
+   Q_CHECK_PTR(parser);
+}
+
+MimeInfoMatCommand::~MimeInfoMatCommand() = default;
+
+int MimeInfoMatCommand::run(const QStringList & /*arguments*/)
+{
+    MimeInfoData data;
+    QString errorMessage;
+
+    switch(parseCommandLine(parser(), &data, &errorMessage)) {
+    case CommandLineOk:
+        break;
+    case CommandLineError:
+        std::cerr << qPrintable(errorMessage);
+        std::cerr << "\n\n";
+        std::cerr << qPrintable(parser()->helpText());
+        return EXIT_FAILURE;
+    case CommandLineVersionRequested:
+        showVersion();
+        Q_UNREACHABLE();
+    case CommandLineHelpRequested:
+        showHelp();
+        Q_UNREACHABLE();
+    }
+
+    output()->setFormat(data.format);
+
+    MatMimeInfo mimeInfo;
+    bool success = true;
+    // One record per requested mimetype, in order, unknown ones included
+    auto write = [this, &mimeInfo, &success](const QString &mimeType) {
+        const MatMimeInfo::Info &info = mimeInfo.info(mimeType);
+        if (!info.valid) {
+            std::cerr << qPrintable(u"Unknown mimetype '%1'\n"_s.arg(mimeType));
+            success = false;
+        }
+        const QString parents = info.parents.join(u';');
+        output()->write({{"mimetype"_L1, mimeType}, {"name"_L1, info.name}, {"comment"_L1, info.comment},
+                         {"icon"_L1, info.iconName}, {"generic-icon"_L1, info.genericIconName},
+                         {"parents"_L1, parents}});
+    };
+
+    for (const QString &mimeType : std::as_const(data.mimeTypes))
+        write(mimeType);
+
+    if (data.readStdin) {
+        MatLineReader reader(stdin, data.nulSeparated ? '\0' : '\n');
+        QString mimeType;
+        while (reader.next(&mimeType)) {
+            const QStringView trimmed = QStringView(mimeType).trimmed();
+            if (trimmed.size() != mimeType.size())
+                mimeType = trimmed.toString();
+            if (!mimeType.isEmpty())
+                write(mimeType);
+        }
+        if (reader.hasError()) {
+            std::cerr << "Could not read the standard input\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -19,14 +19,15 @@
  */
 #include "mimetypematcommand.h"
 #include "matglobals.h"
-
-#include "xdgdesktopfile.h"
-#include "xdgmimeapps.h"
+#include "matglobmatcher.h"
+#include "matfileprobe.h"
+#include "matlinereader.h"
+#include "matmimeinfo.h"
+#include "matpath.h"
 
 #include <QCommandLineOption>
 #include <QCommandLineParser>
 #include <QCoreApplication>
-#include <QDebug>
 #include <QFileInfo>
 #include <QMimeDatabase>
 #include <QMimeType>
@@ -34,10 +35,29 @@
 #include <QtGlobal>
 #include <QUrl>
 
+#include <cstring>
 #include <iostream>
 
+#include <sys/stat.h>
+
 using namespace Qt::Literals::StringLiterals;
 
+// What QMimeDatabase looks at for magic rules
+static constexpr qsizetype HeaderSize = 16 * 1024;
+
+struct MimeTypeData {
+    MimeTypeData() : format(MatOutput::TextFormat), nameOnly(false), content(false), readStdin(false),
+                     nulSeparated(false), queueDepth(32) {}
+
+    MatOutput::Format format;
+    bool nameOnly;
+    bool content;
+    bool readStdin;
+    bool nulSeparated;
+    int queueDepth;
+    QStringList files;
+};
+
 MimeTypeMatCommand::MimeTypeMatCommand(QCommandLineParser *parser)
     : MatCommandInterface(u"mimetype"_s,
                           u"Determines a file (mime)type"_s,
@@ -47,14 +67,32 @@ MimeTypeMatCommand::MimeTypeMatCommand(QCommandLineParser *parser)
 
 MimeTypeMatCommand::~MimeTypeMatCommand() = default;
 
-static CommandLineParseResult parseCommandLine(QCommandLineParser *parser, QString *file, QString *errorMessage)
+static CommandLineParseResult parseCommandLine(QCommandLineParser *parser, MimeTypeData *data, QString *errorMessage)
 {
     parser->clearPositionalArguments();
     parser->setApplicationDescription(u"Determines a file (mime)type"_s);
 
     parser->addPositionalArgument(u"mimetype"_s, u"file | URL"_s,
-                                  QCoreApplication::tr("[file | URL]"));
+                                  QCoreApplication::tr("[file | URL...]"));
 
+    const QCommandLineOption nameOnlyOption(QStringList() << u"name-only"_s,
+                u"Classify by the name only, the files needn't exist"_s);
+    const QCommandLineOption contentOption(QStringList() << u"content"_s,
+                u"Also look at the contents of regular files"_s);
+    const QCommandLineOption queueDepthOption(QStringList() << u"queue-depth"_s,
+                u"The file system requests in flight at once (default: 32)"_s, u"count"_s, u"32"_s);
+    const QCommandLineOption stdinOption(QStringList() << u"stdin"_s,
+                u"Also read files from the standard input, one per line"_s);
+    const QCommandLineOption nulOption(QStringList() << u"z"_s << u"null"_s,
+                u"With --stdin, the files are NUL terminated"_s);
+
+    const QCommandLineOption formatOption = MatOutput::formatOption();
+    parser->addOption(nameOnlyOption);
+    parser->addOption(contentOption);
+    parser->addOption(queueDepthOption);
+    parser->addOption(stdinOption);
+    parser->addOption(nulOption);
+    parser->addOption(formatOption);
     const QCommandLineOption helpOption = parser->addHelpOption();
     const QCommandLineOption versionOption = parser->addVersionOption();
 
@@ -71,19 +109,36 @@ static CommandLineParseResult parseCommandLine(QCommandLineParser *parser, QStri
         return CommandLineHelpRequested;
     }
 
-    QStringList fs = parser->positionalArguments();
-    if (fs.size() < 2) {
-        *errorMessage = u"No file given"_s;
+    if (!MatOutput::formatFromName(parser->value(formatOption), &data->format)) {
+        *errorMessage = u"Unknown output format: "_s + parser->value(formatOption);
         return CommandLineError;
     }
 
+    QStringList fs = parser->positionalArguments();
     fs.removeAt(0);
 
-    if (fs.size() > 1) {
-        *errorMessage = u"Only one file, please"_s;
+    data->nameOnly = parser->isSet(nameOnlyOption);
+    data->content = parser->isSet(contentOption);
+    if (data->nameOnly && data->content) {
+        *errorMessage = u"--name-only and --content are exclusive"_s;
         return CommandLineError;
     }
-    *file = fs.at(0);
+
+    bool ok = false;
+    data->queueDepth = parser->value(queueDepthOption).toInt(&ok);
+    if (!ok || data->queueDepth < 1) {
+        *errorMessage = u"Invalid queue depth: "_s + parser->value(queueDepthOption);
+        return CommandLineError;
+    }
+
+    data->readStdin = parser->isSet(stdinOption);
+    data->nulSeparated = parser->isSet(nulOption);
+    if (fs.isEmpty() && !data->readStdin) {
+        *errorMessage = u"No file given"_s;
+        return CommandLineError;
+    }
+
+    data->files = fs;
 
     return CommandLineOk;
 }
@@ -92,10 +147,10 @@ int MimeTypeMatCommand::run(const QStringList &arguments)
 {
     Q_UNUSED(arguments);
 
+    MimeTypeData data;
     QString errorMessage;
-    QString file;
 
-    switch(parseCommandLine(parser(), &file, &errorMessage)) {
+    switch(parseCommandLine(parser(), &data, &errorMessage)) {
     case CommandLineOk:
         break;
     case CommandLineError:
@@ -111,31 +166,114 @@ int MimeTypeMatCommand::run(const QStringList &arguments)
         Q_UNREACHABLE();
     }
 
-    bool isLocalFile = false;
-    QString localFilename;
-    const QUrl url(file);
-    const QString scheme = url.scheme();
-    if (scheme.isEmpty()) {
-        isLocalFile = true;
-        localFilename = file;
-    } else if (scheme == "file"_L1) {
-        isLocalFile = true;
-        localFilename = QUrl(file).toLocalFile();
-    }
+    output()->setFormat(data.format);
 
-    if (isLocalFile) {
-        const QFileInfo info(file);
-        if (!info.exists(localFilename)) {
-            std::cerr << qPrintable(u"Cannot access '%1': No such file or directory\n"_s.arg(file));
+    // Without globs2 files, e.g. Qt's own database, QMimeDatabase decides
+    MatGlobMatcher matcher;
+    const bool useMatcher = matcher.load() && !matcher.isEmpty();
+    QMimeDatabase *db = MatMimeInfo::database();
+    const QString defaultMimeType = u"application/octet-stream"_s;
+    QString fallback;
+
+    auto mimeTypeForName = [&](QStringView name) -> QStringView {
+        if (useMatcher) {
+            const QStringView mimeType = matcher.match(name);
+            return mimeType.isEmpty() ? QStringView(defaultMimeType) : mimeType;
+        }
+        const QList<QMimeType> mimeTypes = db->mimeTypesForFileName(name.toString());
+        fallback = mimeTypes.isEmpty() ? defaultMimeType : mimeTypes.constFirst().name();
+        return fallback;
+    };
+
+    // The historical output for a single file is the bare mimetype
+    const bool bare = data.files.size() == 1 && !data.readStdin;
+    bool success = true;
+    MatPath path;
+
+    // The files are probed a batch at a time, with many stats and reads in
+    // flight, then reported in order
+    MatFileProbe probe(data.queueDepth, data.content ? HeaderSize : 0);
+    const qsizetype batchSize = qMax<qsizetype>(256, qsizetype(data.queueDepth) * 4);
+    QList<MatFileProbe::Entry> batch; // kept between batches, with the buffers of the entries
+    QStringList batchFiles;
+    QStringList batchLocals;
+    qsizetype pending = 0;
+
+    auto flush = [&]() {
+        if (pending == 0)
+            return;
+        batch.resize(pending); // only the last batch shrinks
+        probe.run(&batch);
+
+        for (qsizetype i = 0; i < pending; ++i) {
+            const MatFileProbe::Entry &entry = batch.at(i);
+            const QString &file = batchFiles.at(i);
+            const QString &local = batchLocals.at(i).isNull() ? file : batchLocals.at(i);
+            if (entry.error != 0) {
+                std::cerr << qPrintable(u"Cannot access '%1': %2\n"_s.arg(file, QString::fromLocal8Bit(std::strerror(entry.error))));
+                success = false;
+            } else if (S_ISREG(entry.mode) && data.content) {
+                const QString mimeType = db->mimeTypeForFileNameAndData(local, entry.header).name();
+                output()->write({{"file"_L1, file}, {"mimetype"_L1, mimeType}}, bare ? QStringView(mimeType) : QStringView());
+            } else if (S_ISREG(entry.mode)) {
+                const QStringView mimeType = mimeTypeForName(local);
+                output()->write({{"file"_L1, file}, {"mimetype"_L1, mimeType}}, bare ? mimeType : QStringView());
+            } else { // directories and other inodes
+                const QString mimeType = db->mimeTypeForFile(QFileInfo(local), QMimeDatabase::MatchExtension).name();
+                output()->write({{"file"_L1, file}, {"mimetype"_L1, mimeType}}, bare ? QStringView(mimeType) : QStringView());
+            }
+        }
+
+        batchFiles.resize(0);
+        batchLocals.resize(0);
+        pending = 0;
+    };
+
+    auto classify = [&](const QString &file) {
+        if (data.nameOnly) {
+            const QStringView mimeType = mimeTypeForName(file);
+            output()->write({{"file"_L1, file}, {"mimetype"_L1, mimeType}}, bare ? mimeType : QStringView());
+            return;
+        }
+
+        // Plain paths, the common case, are looked at without any temporary
+        QString localFilename;
+        const QStringView scheme = MatPath::urlScheme(file);
+        if (!scheme.isEmpty() && !path.exists(file)) {
+            if (scheme.compare("file"_L1, Qt::CaseInsensitive) != 0) { // not a local file
+                std::cerr << qPrintable(u"Can't handle '%1': '%2' scheme not supported\n"_s.arg(file, scheme));
+                success = false;
+                return;
+            }
+            localFilename = QUrl(file).toLocalFile();
+        }
+
+        if (pending == batch.size())
+            batch.append(MatFileProbe::Entry());
+        MatPath::encode(localFilename.isNull() ? file : localFilename, &batch[pending].path);
+        batchFiles.append(file);
+        batchLocals.append(localFilename);
+        if (++pending == batchSize)
+            flush();
+    };
+
+    for (const QString &file : std::as_const(data.files))
+        classify(file);
+
+    if (data.readStdin) {
+        MatLineReader reader(stdin, data.nulSeparated ? '\0' : '\n');
+        QString file;
+        while (reader.next(&file)) {
+            if (!file.isEmpty())
+                classify(file);
+        }
+        if (reader.hasError()) {
+            flush();
+            std::cerr << "Could not read the standard input\n";
             return EXIT_FAILURE;
-        } else {
-            QMimeDatabase mimeDb;
-            const QMimeType mimeType = mimeDb.mimeTypeForFile(info, QMimeDatabase::MatchExtension);
-            std::cout << qPrintable(mimeType.name()) << "\n";
-            return EXIT_SUCCESS;
         }
-    } else { // not a local file
-        std::cerr << qPrintable(u"Can't handle '%1': '%2' scheme not supported\n"_s.arg(file, scheme));
-        return EXIT_FAILURE;
     }
+    flush();
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
 }
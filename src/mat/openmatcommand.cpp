@@ -19,7 +19,10 @@
  */
 
 #include "openmatcommand.h"
+#include "matdbusactivation.h"
 #include "matglobals.h"
+#include "matlinereader.h"
+#include "matpath.h"
 
 #include "xdgdesktopfile.h"
 #include "xdgmimeapps.h"
@@ -28,15 +31,25 @@
 #include <QCommandLineParser>
 #include <QCoreApplication>
 #include <QDebug>
+#include <QFile>
 #include <QFileInfo>
+#include <QHash>
 #include <QMimeDatabase>
 #include <QMimeType>
 #include <QStringList>
 #include <QtGlobal>
 #include <QUrl>
 
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
 
+#include <limits.h>
+#include <unistd.h>
+
+extern char **environ;
+
 using namespace Qt::Literals::StringLiterals;
 
 OpenMatCommand::OpenMatCommand(QCommandLineParser *parser)
@@ -48,7 +61,43 @@ OpenMatCommand::OpenMatCommand(QCommandLineParser *parser)
 
 OpenMatCommand::~OpenMatCommand() = default;
 
-static CommandLineParseResult parseCommandLine(QCommandLineParser *parser, QStringList *files, QString *errorMessage)
+// %U and %F take all the targets in one process, %u and %f just one
+static bool acceptsManyTargets(const XdgDesktopFile &app)
+{
+    const QString exec = app.value(u"Exec"_s).toString();
+    return exec.contains("%U"_L1) || exec.contains("%F"_L1);
+}
+
+// The bytes the targets of one launch may take. It leaves the environment and
+// some headroom for the rest of the Exec line below ARG_MAX, and is capped so
+// a long stream of targets only holds a chunk per application in memory.
+static qsizetype launchBudget()
+{
+    constexpr qsizetype Headroom = 32 * 1024;
+    constexpr qsizetype MaxBudget = 1024 * 1024;
+
+    qsizetype argMax = ::sysconf(_SC_ARG_MAX);
+    if (argMax <= 0)
+        argMax = _POSIX_ARG_MAX;
+
+    qsizetype envSize = 0;
+    for (char **env = environ; *env != nullptr; ++env)
+        envSize += qsizetype(qstrlen(*env)) + 1 + qsizetype(sizeof(char *));
+
+    return qBound<qsizetype>(4096, argMax - envSize - Headroom, MaxBudget);
+}
+
+struct OpenData {
+    OpenData() : format(MatOutput::TextFormat), readStdin(false), nulSeparated(false) {}
+
+    MatOutput::Format format;
+    QStringList files;
+    bool readStdin;
+    QString fromFile;
+    bool nulSeparated;
+};
+
+static CommandLineParseResult parseCommandLine(QCommandLineParser *parser, OpenData *data, QString *errorMessage)
 {
     parser->clearPositionalArguments();
     parser->setApplicationDescription(u"Open files with the default application"_s);
@@ -56,6 +105,18 @@ static CommandLineParseResult parseCommandLine(QCommandLineParser *parser, QStri
     parser->addPositionalArgument(u"open"_s, u"files | URLs"_s,
                                   QCoreApplication::tr("[files | URLs]"));
 
+    const QCommandLineOption stdinOption(QStringList() << u"stdin"_s,
+                u"Also read targets from the standard input, one per line"_s);
+    const QCommandLineOption fromFileOption(QStringList() << u"from-file"_s,
+                u"Also read targets from file, one per line"_s, u"file"_s);
+    const QCommandLineOption nulOption(QStringList() << u"z"_s << u"null"_s,
+                u"With --stdin or --from-file, the targets are NUL terminated"_s);
+
+    const QCommandLineOption formatOption = MatOutput::formatOption();
+    parser->addOption(stdinOption);
+    parser->addOption(fromFileOption);
+    parser->addOption(nulOption);
+    parser->addOption(formatOption);
     const QCommandLineOption helpOption = parser->addHelpOption();
     const QCommandLineOption versionOption = parser->addVersionOption();
 
@@ -72,15 +133,23 @@ static CommandLineParseResult parseCommandLine(QCommandLineParser *parser, QStri
         return CommandLineHelpRequested;
     }
 
-    QStringList fs = parser->positionalArguments();
-    if (fs.size() < 2) {
-        *errorMessage = u"No file or URL given"_s;
+    if (!MatOutput::formatFromName(parser->value(formatOption), &data->format)) {
+        *errorMessage = u"Unknown output format: "_s + parser->value(formatOption);
         return CommandLineError;
     }
 
+    QStringList fs = parser->positionalArguments();
     fs.removeAt(0);
 
-    *files = fs;
+    data->readStdin = parser->isSet(stdinOption);
+    data->fromFile = parser->value(fromFileOption);
+    data->nulSeparated = parser->isSet(nulOption);
+    if (fs.isEmpty() && !data->readStdin && data->fromFile.isEmpty()) {
+        *errorMessage = u"No file or URL given"_s;
+        return CommandLineError;
+    }
+
+    data->files = fs;
 
     return CommandLineOk;
 }
@@ -91,9 +160,9 @@ int OpenMatCommand::run(const QStringList &arguments)
 
     bool success = true;
     QString errorMessage;
-    QStringList files;
+    OpenData data;
 
-    switch(parseCommandLine(parser(), &files, &errorMessage)) {
+    switch(parseCommandLine(parser(), &data, &errorMessage)) {
     case CommandLineOk:
         break;
     case CommandLineError:
@@ -109,47 +178,185 @@ int OpenMatCommand::run(const QStringList &arguments)
         Q_UNREACHABLE();
     }
 
+    output()->setFormat(data.format);
+
+    FILE *fromFile = nullptr;
+    if (!data.fromFile.isEmpty()) {
+        fromFile = ::fopen(QFile::encodeName(data.fromFile).constData(), "re");
+        if (fromFile == nullptr) {
+            std::cerr << qPrintable(u"Cannot open %1: %2\n"_s.arg(data.fromFile,
+                                                                  QString::fromLocal8Bit(std::strerror(errno))));
+            return EXIT_FAILURE;
+        }
+    }
+
     XdgMimeApps appsDb;
     QMimeDatabase mimeDb;
-    XdgDesktopFile *df = nullptr;
-    bool isLocalFile = false;
-    QString localFilename;
-    for (const QString &urlString : std::as_const(files)) {
-        const QUrl url(urlString);
-        const QString scheme = url.scheme();
-        if (scheme.isEmpty()) {
-            isLocalFile = true;
-            localFilename = urlString;
-        } else if (scheme == "file"_L1) {
-            isLocalFile = true;
-            localFilename = QUrl(urlString).toLocalFile();
+
+    // The targets opening with the same application go to it together, in
+    // chunks of at most launchBudget() bytes, so a stream of any length
+    // neither holds all its targets nor overflows ARG_MAX
+    struct Target {
+        QString argument; //!< As given on the command line
+        QString target;   //!< As passed to the application
+        bool isUrl;       //!< Otherwise a local file
+    };
+    struct Handler {
+        XdgDesktopFile *app;
+        QString id;
+        bool manyTargets;
+        QList<Target> targets;
+        qsizetype pendingBytes;
+    };
+    QList<Handler> handlers;
+    QHash<QString, qsizetype> handlerByType; // -1 if no handler
+    QHash<QString, qsizetype> handlerByFile;
+    const qsizetype budget = launchBudget();
+
+    auto handlerFor = [&](const QString &contentType) -> qsizetype {
+        const auto it = handlerByType.constFind(contentType);
+        if (it != handlerByType.constEnd())
+            return *it;
+
+        qsizetype index = -1;
+        if (XdgDesktopFile *df = appsDb.defaultApp(contentType)) {
+            const auto fileIt = handlerByFile.constFind(df->fileName());
+            if (fileIt != handlerByFile.constEnd()) {
+                index = *fileIt;
+                delete df;
+            } else {
+                index = handlers.size();
+                handlerByFile.insert(df->fileName(), index);
+                handlers.append(Handler{df, XdgDesktopFile::id(df->fileName()), acceptsManyTargets(*df), {}, 0});
+            }
         }
+        handlerByType.insert(contentType, index);
+        return index;
+    };
+
+    QStringList targets; // its capacity is reused by every launch
+    QList<QUrl> urls;    // as is this one's
+    auto launch = [&](Handler &handler) {
+        if (handler.targets.isEmpty())
+            return;
+
+        targets.resize(0);
+        for (const Target &t : std::as_const(handler.targets))
+            targets.append(t.target);
 
-        if (isLocalFile) {
-            const QFileInfo f (localFilename);
-            if (!f.exists()) {
-                std::cerr << qPrintable(u"Cannot access %1: No such file or directory\n"_s.arg(urlString));
-                break;
+        // A running DBusActivatable application takes them in one call. It
+        // doesn't run in our directory, the files go as absolute paths.
+        bool opened = false;
+        if (MatDBusActivation::isActivatable(*handler.app)) {
+            urls.resize(0);
+            for (const Target &t : std::as_const(handler.targets))
+                urls.append(t.isUrl ? QUrl(t.target) : QUrl::fromLocalFile(QFileInfo(t.target).absoluteFilePath()));
+            opened = MatDBusActivation::open(handler.id, urls);
+        }
+        if (!opened) {
+            if (handler.manyTargets) {
+                opened = handler.app->startDetached(targets);
             } else {
-                const QMimeType mimeType = mimeDb.mimeTypeForFile(f);
-                df = appsDb.defaultApp(mimeType.name());
+                opened = true;
+                for (const QString &target : std::as_const(targets))
+                    opened = handler.app->startDetached(target) && opened;
             }
-        } else { // not a local file
-			const QString contentType = u"x-scheme-handler/%1"_s.arg(scheme);
-			df = appsDb.defaultApp(contentType);
         }
 
-        if (df) { // default app found
-            if (!df->startDetached(isLocalFile ? localFilename : urlString)) {
+        for (const Target &t : std::as_const(handler.targets)) {
+            if (!opened) {
                 std::cerr << qPrintable(
-                        u"Error while running the default application (%1) for %2\n"_s.arg(df->name(), urlString));
+                        u"Error while running the default application (%1) for %2\n"_s.arg(handler.app->name(), t.argument));
                 success = false;
             }
-            delete df;
-            df = nullptr;
-        } else { // no default app found
-            std::cout << qPrintable(u"No default application for '%1'\n"_s.arg(urlString));
+            if (output()->isStructured()) {
+                output()->write({{"target"_L1, t.argument}, {"id"_L1, handler.id},
+                                 {"status"_L1, opened ? u"launched" : u"failed"}});
+            }
         }
+        handler.targets.resize(0);
+        handler.pendingBytes = 0;
+    };
+
+    MatPath path;
+    QString contentType; // its capacity is reused by every target
+    auto openTarget = [&](const QString &argument) {
+        QString target = argument;
+        const QStringView scheme = MatPath::urlScheme(argument);
+        // an existing file named like a URL, e.g. "a:b", is a file
+        bool exists = path.exists(argument);
+        bool isUrl = false;
+        if (!exists && !scheme.isEmpty()) {
+            if (scheme.compare("file"_L1, Qt::CaseInsensitive) == 0) {
+                target = QUrl(argument).toLocalFile();
+                exists = path.exists(target);
+            } else {
+                isUrl = true;
+            }
+        }
+
+        if (isUrl) {
+            contentType.resize(0);
+            contentType.append("x-scheme-handler/"_L1);
+            for (const QChar c : scheme)
+                contentType.append(c.toLower());
+        } else if (!exists) {
+            std::cerr << qPrintable(u"Cannot access %1: No such file or directory\n"_s.arg(argument));
+            success = false;
+            return;
+        } else {
+            contentType = mimeDb.mimeTypeForFile(target).name();
+        }
+
+        const qsizetype index = handlerFor(contentType);
+        if (index < 0) {
+            output()->write({{"target"_L1, argument}, {"id"_L1, QStringView()}, {"status"_L1, u"no-handler"}},
+                            u"No default application for '%1'"_s.arg(argument));
+            return;
+        }
+
+        // Its argv bytes, a %U handler may get it as a percent encoded URL
+        qsizetype bytes = qsizetype(qstrlen(path.encode(target)));
+        if (handlers.at(index).manyTargets)
+            bytes = 3 * bytes + qsizetype(sizeof("file://"));
+        bytes += 1 + qsizetype(sizeof(char *));
+
+        Handler &handler = handlers[index];
+        if (!handler.targets.isEmpty() && handler.pendingBytes + bytes > budget)
+            launch(handler);
+        handler.targets.append(Target{argument, target, isUrl});
+        handler.pendingBytes += bytes;
+    };
+
+    for (const QString &file : std::as_const(data.files))
+        openTarget(file);
+
+    auto openStream = [&](FILE *stream, const char *name) -> bool {
+        MatLineReader reader(stream, data.nulSeparated ? '\0' : '\n');
+        QString file;
+        while (reader.next(&file)) {
+            if (!file.isEmpty())
+                openTarget(file);
+        }
+        if (reader.hasError()) {
+            std::cerr << "Could not read " << name << "\n";
+            return false;
+        }
+        return true;
+    };
+
+    if (data.readStdin)
+        success = openStream(stdin, "the standard input") && success;
+    if (fromFile != nullptr) {
+        success = openStream(fromFile, qPrintable(data.fromFile)) && success;
+        ::fclose(fromFile);
     }
+
+    for (Handler &handler : handlers)
+        launch(handler);
+
+    for (const Handler &handler : std::as_const(handlers))
+        delete handler.app;
+
     return success ? EXIT_SUCCESS : EXIT_FAILURE;
 }
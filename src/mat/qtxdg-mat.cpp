@@ -20,17 +20,29 @@
 
 #include "matcommandmanager.h"
 #include "mimetypematcommand.h"
+#include "mimeinfomatcommand.h"
 #include "defappmatcommand.h"
 #include "openmatcommand.h"
-#include "defwebbrowsermatcommand.h"
-#include "defemailclientmatcommand.h"
-#include "deffilemanagermatcommand.h"
-#include "defterminalmatcommand.h"
+#include "defcategorymatcommand.h"
+#include "defaultsmatcommand.h"
+#include "handlesmatcommand.h"
+#include "candidatesmatcommand.h"
+#include "checkmatcommand.h"
+#include "snapshotmatcommand.h"
+#include "diffmatcommand.h"
+#include "restorematcommand.h"
+#include "matallocstats.h"
+#include "matcategoryengine.h"
+#include "matfastpath.h"
+#include "matrecorder.h"
+#include "servematcommand.h"
+#include "terminalexecmatcommand.h"
 
 #include <QCoreApplication>
 #include <QCommandLineOption>
 #include <QCommandLineParser>
 #include <QDebug>
+#include <QScopedPointer>
 
 using namespace Qt::Literals::StringLiterals;
 
@@ -56,6 +68,23 @@ extern void Q_CORE_EXPORT qt_call_post_routines();
 
 int main(int argc, char *argv[])
 {
+    MatRecorder recorder;
+
+    // Plain lookups are answered before any application setup
+    if (MatFastPath::isEnabled()) {
+        QStringList arguments;
+        arguments.reserve(argc - 1);
+        for (int i = 1; i < argc; ++i)
+            arguments.append(QString::fromLocal8Bit(argv[i]));
+
+        int exitCode = EXIT_SUCCESS;
+        if (MatFastPath::run(arguments, &exitCode)) {
+            recorder.record(arguments, exitCode);
+            MatAllocStats::report(MatOutput::recordCount());
+            return exitCode;
+        }
+    }
+
     QCoreApplication app(argc, argv);
     int runResult = 0;
     app.setApplicationName(u"qtxdg-mat"_s);
@@ -69,67 +98,77 @@ int main(int argc, char *argv[])
     parser.addPositionalArgument(u"command"_s,
                                  u"Command to execute."_s);
 
-    QScopedPointer<MatCommandManager> manager(new MatCommandManager());
-
-    MatCommandInterface *const mimeCmd = new DefAppMatCommand(&parser);
-    manager->add(mimeCmd);
-
-    MatCommandInterface *const openCmd = new OpenMatCommand(&parser);
-    manager->add(openCmd);
-
-    MatCommandInterface *const mimeTypeCmd = new MimeTypeMatCommand(&parser);
-    manager->add(mimeTypeCmd);
-
-    MatCommandInterface *const defWebBrowserCmd = new DefWebBrowserMatCommand(&parser);
-    manager->add(defWebBrowserCmd);
-
-    MatCommandInterface *const defEmailClientCmd = new DefEmailClientMatCommand(&parser);
-    manager->add(defEmailClientCmd);
-
-    MatCommandInterface *const defFileManagerCmd = new DefFileManagerMatCommand(&parser);
-    manager->add(defFileManagerCmd);
-
-    MatCommandInterface *const defTerminalCmd = new DefTerminalMatCommand(&parser);
-    manager->add(defTerminalCmd);
-
     // Find out the positional arguments.
     parser.parse(QCoreApplication::arguments());
     const QStringList args = parser.positionalArguments();
+    const QString command = args.value(0);
+
+    // The category engine reads the site categories, only a def- command,
+    // defaults or the help need it
+    QScopedPointer<MatCategoryEngine> categoryEngine;
+    auto engine = [&categoryEngine]() {
+        if (categoryEngine.isNull())
+            categoryEngine.reset(new MatCategoryEngine);
+        return categoryEngine.data();
+    };
+
+    // Only the command that runs gets created
+    MatCommandManager manager;
+    manager.add(u"defapp"_s, [&parser] { return new DefAppMatCommand(&parser); });
+    manager.add(u"open"_s, [&parser] { return new OpenMatCommand(&parser); });
+    manager.add(u"mimetype"_s, [&parser] { return new MimeTypeMatCommand(&parser); });
+    manager.add(u"mimeinfo"_s, [&parser] { return new MimeInfoMatCommand(&parser); });
+
+    manager.add(u"defaults"_s, [&parser, engine] { return new DefaultsMatCommand(engine(), &parser); });
+    manager.add(u"handles"_s, [&parser] { return new HandlesMatCommand(&parser); });
+    manager.add(u"candidates"_s, [&parser] { return new CandidatesMatCommand(&parser); });
+    manager.add(u"check"_s, [&parser] { return new CheckMatCommand(&parser); });
+    manager.add(u"snapshot"_s, [&parser] { return new SnapshotMatCommand(&parser); });
+    manager.add(u"diff"_s, [&parser] { return new DiffMatCommand(&parser); });
+    manager.add(u"restore"_s, [&parser] { return new RestoreMatCommand(&parser); });
+    manager.add(u"serve"_s, [&parser] { return new ServeMatCommand(&parser); });
+    manager.add(u"terminal-exec"_s, [&parser] { return new TerminalExecMatCommand(&parser); });
+
+    if (!manager.contains(command)) {
+        const QList<MatCategory> categories = engine()->categories();
+        for (const MatCategory &category : categories) {
+            manager.add(category.name, [&parser, engine, category] {
+                return new DefCategoryMatCommand(category, engine(), &parser);
+            });
+        }
+    }
+
     if (args.isEmpty()) {
         const QCommandLineOption helpOption = parser.addHelpOption();
         const QCommandLineOption versionOption = parser.addVersionOption();
         parser.parse(QCoreApplication::arguments());
         if (parser.isSet(helpOption) || parser.isSet(u"help-all"_s)) {
-            showHelp(parser.helpText(), manager->descriptionsHelpText(), EXIT_SUCCESS);
+            showHelp(parser.helpText(), manager.descriptionsHelpText(), EXIT_SUCCESS);
             Q_UNREACHABLE();
         }
         if (parser.isSet(versionOption)) {
             parser.showVersion();
             Q_UNREACHABLE();
         }
-        showHelp(parser.helpText(), manager->descriptionsHelpText(), EXIT_FAILURE);
+        showHelp(parser.helpText(), manager.descriptionsHelpText(), EXIT_FAILURE);
         Q_UNREACHABLE();
     }
 
     // we got a command
-    const QString command = args.first();
-
-    bool cmdFound = false;
-    const QList <MatCommandInterface *> commands = manager->commands();
-    for (auto *const cmd : commands) {
-        if (command == cmd->name()) {
-            cmdFound = true;
-            runResult = cmd->run(args);
-        }
-        if (cmdFound)
-            break;
+    MatCommandInterface *const cmd = manager.command(command);
+    const bool cmdFound = cmd != nullptr;
+    if (cmdFound) {
+        runResult = cmd->run(args);
+        cmd->output()->flush();
+        recorder.record(QCoreApplication::arguments().mid(1), runResult);
+        MatAllocStats::report(MatOutput::recordCount());
     }
 
     if (!cmdFound) {
         const QCommandLineOption helpOption = parser.addHelpOption();
         const QCommandLineOption versionOption = parser.addVersionOption();
         parser.parse(QCoreApplication::arguments());
-        showHelp(parser.helpText(), manager->descriptionsHelpText(), EXIT_FAILURE);
+        showHelp(parser.helpText(), manager.descriptionsHelpText(), EXIT_FAILURE);
         Q_UNREACHABLE();
     } else {
         return runResult;
@@ -0,0 +1,195 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "restorematcommand.h"
+
+#include "matdesktopdb.h"
+#include "matglobals.h"
+#include "matmimeappslist.h"
+#include "matmimeappswriter.h"
+#include "matresolver.h"
+#include "matsnapshot.h"
+
+#include <QCommandLineOption>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QString>
+#include <QStringList>
+
+#include <algorithm>
+#include <iostream>
+
+using namespace Qt::Literals::StringLiterals;
+
+static CommandLineParseResult parseCommandLine(QCommandLineParser *parser, QString *fileName,
+                                               MatOutput::Format *format, QString *errorMessage)
+{
+    parser->clearPositionalArguments();
+    parser->setApplicationDescription(u"Set the defaults saved in a snapshot"_s);
+
+    parser->addPositionalArgument(u"restore"_s, u"snapshot"_s,
+                                  QCoreApplication::tr("snapshot"));
+
+    const QCommandLineOption formatOption = MatOutput::formatOption();
+    parser->addOption(formatOption);
+    const QCommandLineOption helpOption = parser->addHelpOption();
+    const QCommandLineOption versionOption = parser->addVersionOption();
+
+    if (!parser->parse(QCoreApplication::arguments())) {
+        *errorMessage = parser->errorText();
+        return CommandLineError;
+    }
+
+    if (parser->isSet(versionOption)) {
+        return CommandLineVersionRequested;
+    }
+
+    if (parser->isSet(helpOption) || parser->isSet(u"help-all"_s)) {
+        return CommandLineHelpRequested;
+    }
+
+    if (!MatOutput::formatFromName(parser->value(formatOption), format)) {
+        *errorMessage = u"Unknown output format: "_s + parser->value(formatOption);
+        return CommandLineError;
+    }
+
+    QStringList posArgs = parser->positionalArguments();
+    posArgs.removeAt(0);
+
+    if (posArgs.size() != 1) {
+        *errorMessage = u"One snapshot, please"_s;
+        return CommandLineError;
+    }
+
+    *fileName = posArgs.constFirst();
+
+    return CommandLineOk;
+}
+
+RestoreMatCommand::RestoreMatCommand(QCommandLineParser *parser)
+    : MatCommandInterface(u"restore"_s,
+                          u"Set the defaults saved in a snapshot"_s,
+                          parser)
+{
+   Q_CHECK_PTR(parser);
+}
+
+RestoreMatCommand::~RestoreMatCommand() = default;
+
+int RestoreMatCommand::run(const QStringList & /*arguments*/)
+{
+    QString fileName;
+    MatOutput::Format format = MatOutput::TextFormat;
+    QString errorMessage;
+
+    switch(parseCommandLine(parser(), &fileName, &format, &errorMessage)) {
+    case CommandLineOk:
+        break;
+    case CommandLineError:
+        std::cerr << qPrintable(errorMessage);
+        std::cerr << "\n\n";
+        std::cerr << qPrintable(parser()->helpText());
+        return EXIT_FAILURE;
+    case CommandLineVersionRequested:
+        showVersion();
+        Q_UNREACHABLE();
+    case CommandLineHelpRequested:
+        showHelp();
+        Q_UNREACHABLE();
+    }
+
+    output()->setFormat(format);
+
+    MatSnapshot::Table snapshot;
+    MatSnapshot::Associations user;
+    if (!MatSnapshot::load(fileName, &snapshot, &errorMessage, &user)) {
+        std::cerr << qPrintable(errorMessage) << '\n';
+        return EXIT_FAILURE;
+    }
+
+    // Only the explicit entries of the user's mimeapps.list are compared and
+    // written: the rest of the effective defaults, the system layers, the
+    // mimetype parents and aliases and the installed applications, isn't
+    // restore's to write. What differs is written in one transaction, and
+    // the diff is made under the writer's lock, no other writer can get in
+    // between.
+    MatMimeAppsWriter writer;
+    if (!writer.lock(&errorMessage)) {
+        std::cerr << qPrintable(u"Could not restore %1: %2\n"_s.arg(fileName, errorMessage));
+        return EXIT_FAILURE;
+    }
+    MatMimeAppsList current(writer.fileName());
+    if (!current.load()) {
+        std::cerr << qPrintable(u"Could not restore %1: %2 can't be read\n"_s.arg(fileName, writer.fileName()));
+        return EXIT_FAILURE;
+    }
+    const MatSnapshot::Associations live = MatSnapshot::associations(current);
+
+    struct Change {
+        MatMimeAppsList::Group group;
+        QString mimeType;
+        QStringList from;
+        QStringList to;
+    };
+    QList<Change> changes;
+    QList<MatSnapshot::Associations::key_type> keys = live.keys() + user.keys();
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    for (const auto &key : std::as_const(keys)) {
+        const QStringList from = live.value(key);
+        const QStringList to = user.value(key);
+        if (from == to)
+            continue;
+        const auto group = static_cast<MatMimeAppsList::Group>(key.first);
+        writer.setApps(group, key.second, to);
+        changes.append(Change{group, key.second, from, to});
+    }
+
+    if (!writer.commit(&errorMessage)) {
+        std::cerr << qPrintable(u"Could not restore %1: %2\n"_s.arg(fileName, errorMessage));
+        return EXIT_FAILURE;
+    }
+
+    // A dropped default may still come from elsewhere, restore can't change that
+    QStringList lowerFileNames = MatMimeAppsLayers::defaultFileNames();
+    lowerFileNames.removeAll(writer.fileName());
+    MatMimeAppsLayers lowerLayers(lowerFileNames);
+    MatDesktopDb db;
+    const MatResolver lower({&lowerLayers}, {&db});
+
+    for (const Change &change : std::as_const(changes)) {
+        const QString from = change.from.join(u';');
+        const QString to = change.to.join(u';');
+        const QString group = MatMimeAppsList::groupName(change.group);
+        const QString text = change.group == MatMimeAppsList::DefaultApplications
+                ? u"%1: %2 -> %3"_s.arg(change.mimeType, from, to)
+                : u"%1: %2 -> %3 (%4)"_s.arg(change.mimeType, from, to, group);
+        output()->write({{"group"_L1, group}, {"mimetype"_L1, change.mimeType},
+                         {"from"_L1, from}, {"to"_L1, to}}, text);
+
+        if (change.group == MatMimeAppsList::DefaultApplications && change.to.isEmpty()) {
+            if (const MatDesktopEntry *app = lower.defaultApp(change.mimeType)) {
+                std::cerr << qPrintable(u"Warning: %1 still defaults to %2, from a system layer or an installed application\n"_s
+                                        .arg(change.mimeType, app->id));
+            }
+        }
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,152 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "servematcommand.h"
+#include "matglobals.h"
+#include "matlauncher.h"
+#include "matserver.h"
+
+#include <QCommandLineOption>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+
+#include <iostream>
+
+using namespace Qt::Literals::StringLiterals;
+
+struct ServeData {
+    QString socketPath;
+    QString metricsFile;
+    QString metricsSocketPath;
+};
+
+static CommandLineParseResult parseCommandLine(QCommandLineParser *parser, ServeData *data, QString *errorMessage)
+{
+    parser->clearPositionalArguments();
+    parser->setApplicationDescription(u"Serve resolution requests on stdin/stdout or on a Unix socket"_s);
+
+    parser->addPositionalArgument(u"serve"_s, ""_L1);
+
+    const QCommandLineOption socketOption(QStringList() << u"socket"_s,
+                u"Serve every user connecting to the Unix socket, instead of stdin/stdout"_s, u"path"_s);
+
+    const QCommandLineOption metricsFileOption(QStringList() << u"metrics-file"_s,
+                u"Write Prometheus metrics to the file every ten seconds"_s, u"path"_s);
+
+    const QCommandLineOption metricsSocketOption(QStringList() << u"metrics-socket"_s,
+                u"Serve Prometheus metrics on the Unix socket"_s, u"path"_s);
+
+    parser->addOption(socketOption);
+    parser->addOption(metricsFileOption);
+    parser->addOption(metricsSocketOption);
+    const QCommandLineOption helpOption = parser->addHelpOption();
+    const QCommandLineOption versionOption = parser->addVersionOption();
+
+    if (!parser->parse(QCoreApplication::arguments())) {
+        *errorMessage = parser->errorText();
+        return CommandLineError;
+    }
+
+    if (parser->isSet(versionOption)) {
+        return CommandLineVersionRequested;
+    }
+
+    if (parser->isSet(helpOption) || parser->isSet(u"help-all"_s)) {
+        return CommandLineHelpRequested;
+    }
+
+    QStringList posArgs = parser->positionalArguments();
+    posArgs.removeAt(0);
+    if (!posArgs.isEmpty()) {
+        *errorMessage = u"Extra arguments given: "_s;
+        errorMessage->append(posArgs.join(u','));
+        return CommandLineError;
+    }
+
+    if (parser->isSet(socketOption)) {
+        data->socketPath = parser->value(socketOption);
+        if (data->socketPath.isEmpty()) {
+            *errorMessage = u"No socket path"_s;
+            return CommandLineError;
+        }
+    }
+
+    data->metricsFile = parser->value(metricsFileOption);
+    data->metricsSocketPath = parser->value(metricsSocketOption);
+
+    return CommandLineOk;
+}
+
+ServeMatCommand::ServeMatCommand(QCommandLineParser *parser)
+    : MatCommandInterface(u"serve"_s,
+                          u"Serve resolution requests on stdin/stdout or on a Unix socket"_s,
+                          parser)
+{
+   Q_CHECK_PTR(parser);
+}
+
+ServeMatCommand::~ServeMatCommand() = default;
+
+int ServeMatCommand::run(const QStringList & /*arguments*/)
+{
+    ServeData data;
+    QString errorMessage;
+
+    switch(parseCommandLine(parser(), &data, &errorMessage)) {
+    case CommandLineOk:
+        break;
+    case CommandLineError:
+        std::cerr << qPrintable(errorMessage);
+        std::cerr << "\n\n";
+        std::cerr << qPrintable(parser()->helpText());
+        return EXIT_FAILURE;
+    case CommandLineVersionRequested:
+        showVersion();
+        Q_UNREACHABLE();
+    case CommandLineHelpRequested:
+        showHelp();
+        Q_UNREACHABLE();
+    }
+
+    // Fork the launcher helper while this process is still small
+    MatLauncher launcher;
+    if (data.socketPath.isEmpty() && !launcher.start())
+        std::cerr << "Could not start the launcher helper, launching directly\n";
+
+    MatServer server;
+    server.setLauncher(&launcher);
+    if (!data.metricsSocketPath.isEmpty() && !server.listenMetrics(data.metricsSocketPath, &errorMessage)) {
+        std::cerr << qPrintable(errorMessage) << "\n";
+        return EXIT_FAILURE;
+    }
+    if (!data.metricsFile.isEmpty())
+        server.setMetricsFile(data.metricsFile);
+
+    if (data.socketPath.isEmpty()) {
+        QObject::connect(&server, &MatServer::finished, QCoreApplication::instance(), &QCoreApplication::quit);
+        server.serveStdio();
+    } else if (!server.listen(data.socketPath, &errorMessage)) {
+        std::cerr << qPrintable(errorMessage) << "\n";
+        return EXIT_FAILURE;
+    }
+
+    return QCoreApplication::exec();
+}
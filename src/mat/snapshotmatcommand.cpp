@@ -0,0 +1,109 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "snapshotmatcommand.h"
+
+#include "matglobals.h"
+#include "matsnapshot.h"
+
+#include <QCommandLineOption>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QString>
+#include <QStringList>
+
+#include <iostream>
+
+using namespace Qt::Literals::StringLiterals;
+
+static CommandLineParseResult parseCommandLine(QCommandLineParser *parser, QString *fileName, QString *errorMessage)
+{
+    parser->clearPositionalArguments();
+    parser->setApplicationDescription(u"Save the default application of every mimetype"_s);
+
+    parser->addPositionalArgument(u"snapshot"_s, u"file"_s,
+                                  QCoreApplication::tr("[file, the standard output by default]"));
+
+    const QCommandLineOption helpOption = parser->addHelpOption();
+    const QCommandLineOption versionOption = parser->addVersionOption();
+
+    if (!parser->parse(QCoreApplication::arguments())) {
+        *errorMessage = parser->errorText();
+        return CommandLineError;
+    }
+
+    if (parser->isSet(versionOption)) {
+        return CommandLineVersionRequested;
+    }
+
+    if (parser->isSet(helpOption) || parser->isSet(u"help-all"_s)) {
+        return CommandLineHelpRequested;
+    }
+
+    QStringList posArgs = parser->positionalArguments();
+    posArgs.removeAt(0);
+
+    if (posArgs.size() > 1) {
+        *errorMessage = u"Only one file, please"_s;
+        return CommandLineError;
+    }
+
+    *fileName = posArgs.value(0, u"-"_s);
+
+    return CommandLineOk;
+}
+
+SnapshotMatCommand::SnapshotMatCommand(QCommandLineParser *parser)
+    : MatCommandInterface(u"snapshot"_s,
+                          u"Save the default application of every mimetype"_s,
+                          parser)
+{
+   Q_CHECK_PTR(parser);
+}
+
+SnapshotMatCommand::~SnapshotMatCommand() = default;
+
+int SnapshotMatCommand::run(const QStringList & /*arguments*/)
+{
+    QString fileName;
+    QString errorMessage;
+
+    switch(parseCommandLine(parser(), &fileName, &errorMessage)) {
+    case CommandLineOk:
+        break;
+    case CommandLineError:
+        std::cerr << qPrintable(errorMessage);
+        std::cerr << "\n\n";
+        std::cerr << qPrintable(parser()->helpText());
+        return EXIT_FAILURE;
+    case CommandLineVersionRequested:
+        showVersion();
+        Q_UNREACHABLE();
+    case CommandLineHelpRequested:
+        showHelp();
+        Q_UNREACHABLE();
+    }
+
+    if (!MatSnapshot::save(MatSnapshot::live(), MatSnapshot::userLive(), fileName, &errorMessage)) {
+        std::cerr << qPrintable(errorMessage) << '\n';
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,189 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+
+#include "terminalexecmatcommand.h"
+
+#include "matglobals.h"
+
+#include "xdgdefaultapps.h"
+#include "xdgdesktopfile.h"
+
+#include <QByteArrayList>
+#include <QCommandLineOption>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFile>
+#include <QScopedPointer>
+#include <QString>
+#include <QStringList>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace Qt::Literals::StringLiterals;
+
+struct TerminalExecData {
+    TerminalExecData() : print(false), format(MatOutput::TextFormat) {}
+
+    bool print;
+    MatOutput::Format format;
+    QStringList command;
+};
+
+static CommandLineParseResult parseCommandLine(QCommandLineParser *parser, TerminalExecData *data, QString *errorMessage)
+{
+    parser->clearPositionalArguments();
+    parser->setApplicationDescription(u"Run a command in the default terminal"_s);
+
+    parser->addPositionalArgument(u"terminal-exec"_s, u"the command to run, after --"_s,
+                                  QCoreApplication::tr("-- command [argument...]"));
+
+    const QCommandLineOption printOption(u"print"_s,
+            u"Print the terminal command line, one argument per line, instead of running it"_s);
+    parser->addOption(printOption);
+    const QCommandLineOption formatOption = MatOutput::formatOption();
+    parser->addOption(formatOption);
+    const QCommandLineOption helpOption = parser->addHelpOption();
+    const QCommandLineOption versionOption = parser->addVersionOption();
+
+    if (!parser->parse(QCoreApplication::arguments())) {
+        *errorMessage = parser->errorText();
+        return CommandLineError;
+    }
+
+    if (parser->isSet(versionOption)) {
+        return CommandLineVersionRequested;
+    }
+
+    if (parser->isSet(helpOption) || parser->isSet(u"help-all"_s)) {
+        return CommandLineHelpRequested;
+    }
+
+    if (!MatOutput::formatFromName(parser->value(formatOption), &data->format)) {
+        *errorMessage = u"Unknown output format: "_s + parser->value(formatOption);
+        return CommandLineError;
+    }
+
+    QStringList posArgs = parser->positionalArguments();
+    posArgs.removeAt(0);
+
+    if (posArgs.isEmpty()) {
+        *errorMessage = u"Command missing"_s;
+        return CommandLineError;
+    }
+
+    data->print = parser->isSet(printOption);
+    data->command = posArgs;
+    return CommandLineOk;
+}
+
+// The argument that makes the terminal run the rest of its command line.
+// X-TerminalArgExec is the key terminals declare for it, X-ExecArg the older
+// GNOME one. Terminals without either take xterm's -e.
+static QString execArgument(const XdgDesktopFile &terminal)
+{
+    if (terminal.contains(u"X-TerminalArgExec"_s))
+        return terminal.value(u"X-TerminalArgExec"_s).toString();
+    if (terminal.contains(u"X-ExecArg"_s))
+        return terminal.value(u"X-ExecArg"_s).toString();
+    return u"-e"_s;
+}
+
+TerminalExecMatCommand::TerminalExecMatCommand(QCommandLineParser *parser)
+    : MatCommandInterface(u"terminal-exec"_s,
+                          u"Run a command in the default terminal"_s,
+                          parser)
+{
+   Q_CHECK_PTR(parser);
+}
+
+TerminalExecMatCommand::~TerminalExecMatCommand() = default;
+
+int TerminalExecMatCommand::run(const QStringList & /*arguments*/)
+{
+    TerminalExecData data;
+    QString errorMessage;
+
+    switch(parseCommandLine(parser(), &data, &errorMessage)) {
+    case CommandLineOk:
+        break;
+    case CommandLineError:
+        std::cerr << qPrintable(errorMessage);
+        std::cerr << "\n\n";
+        std::cerr << qPrintable(parser()->helpText());
+        return EXIT_FAILURE;
+    case CommandLineVersionRequested:
+        showVersion();
+        Q_UNREACHABLE();
+    case CommandLineHelpRequested:
+        showHelp();
+        Q_UNREACHABLE();
+    }
+
+    output()->setFormat(data.format);
+
+    const QScopedPointer<XdgDesktopFile> terminal(XdgDefaultApps::terminal());
+    if (terminal.isNull() || !terminal->isValid()) {
+        std::cerr << "No default terminal\n";
+        return EXIT_FAILURE;
+    }
+
+    QStringList args = terminal->expandExecString();
+    if (args.isEmpty()) {
+        std::cerr << "Invalid Exec key in " << qPrintable(terminal->fileName()) << "\n";
+        return EXIT_FAILURE;
+    }
+    const QString execArg = execArgument(*terminal);
+    if (!execArg.isEmpty())
+        args.append(execArg);
+    args.append(data.command);
+
+    if (data.print) {
+        for (const QString &arg : std::as_const(args))
+            output()->write({{"arg"_L1, arg}}, arg);
+        return EXIT_SUCCESS;
+    }
+
+    QByteArrayList encoded;
+    encoded.reserve(args.size());
+    std::vector<char *> argv;
+    argv.reserve(args.size() + 1);
+    for (const QString &arg : std::as_const(args)) {
+        encoded.append(QFile::encodeName(arg));
+        argv.push_back(encoded.last().data());
+    }
+    argv.push_back(nullptr);
+
+    // Nothing runs after a successful exec
+    output()->flush();
+    std::fflush(stdout);
+    std::fflush(stderr);
+
+    ::execvp(argv[0], argv.data());
+
+    std::cerr << "Failed to run " << argv[0] << ": " << std::strerror(errno) << "\n";
+    return EXIT_FAILURE;
+}
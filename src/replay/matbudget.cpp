@@ -0,0 +1,115 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "matbudget.h"
+
+#include <QFileInfo>
+#include <QSettings>
+
+using namespace Qt::Literals::StringLiterals;
+
+static constexpr QLatin1StringView AllocsPerItem("allocs-per-item");
+
+bool MatBudget::load(const QString &fileName, const QString &machineClass, QString *errorMessage)
+{
+    if (!QFileInfo(fileName).isReadable()) {
+        *errorMessage = u"Could not read %1"_s.arg(fileName);
+        return false;
+    }
+
+    QSettings settings(fileName, QSettings::IniFormat);
+    if (!settings.childGroups().contains(machineClass)) {
+        *errorMessage = u"%1 has no budgets for the machine class '%2'"_s.arg(fileName, machineClass);
+        return false;
+    }
+
+    mBudgets.clear();
+    settings.beginGroup(machineClass);
+    const QStringList commands = settings.childGroups();
+    for (const QString &command : commands) {
+        settings.beginGroup(command);
+        const QStringList statistics = settings.childKeys();
+        for (const QString &statistic : statistics) {
+            bool ok = false;
+            const double ms = settings.value(statistic).toDouble(&ok);
+            if (!ok) {
+                *errorMessage = u"Invalid budget %1/%2/%3"_s.arg(machineClass, command, statistic);
+                return false;
+            }
+            mBudgets[command].insert(statistic, ms);
+        }
+        settings.endGroup();
+    }
+    settings.endGroup();
+    return true;
+}
+
+QStringList MatBudget::check(const QString &command, const QList<qint64> &latencies) const
+{
+    QStringList violations;
+    if (latencies.isEmpty())
+        return violations;
+
+    const QHash<QString, double> budgets = mBudgets.value(command);
+    for (auto it = budgets.cbegin(); it != budgets.cend(); ++it) {
+        qint64 value;
+        if (it.key() == AllocsPerItem) {
+            continue; // see checkAllocations()
+        } else if (it.key() == "max"_L1) {
+            value = latencies.constLast();
+        } else if (it.key().startsWith(u'p')) {
+            bool ok = false;
+            const double p = it.key().mid(1).toDouble(&ok);
+            if (!ok || p < 0 || p > 100) {
+                violations.append(u"%1/%2: unknown statistic"_s.arg(command, it.key()));
+                continue;
+            }
+            value = percentile(latencies, p);
+        } else {
+            violations.append(u"%1/%2: unknown statistic"_s.arg(command, it.key()));
+            continue;
+        }
+
+        const double ms = double(value) / 1000.0;
+        if (ms > it.value())
+            violations.append(u"%1/%2: %3ms over the %4ms budget"_s.arg(command, it.key()).arg(ms, 0, 'f', 2).arg(it.value()));
+    }
+    violations.sort();
+    return violations;
+}
+
+QStringList MatBudget::checkAllocations(const QString &command, double perItem) const
+{
+    const auto budgets = mBudgets.constFind(command);
+    if (budgets == mBudgets.constEnd())
+        return {};
+    const auto budget = budgets->constFind(AllocsPerItem);
+    if (budget == budgets->constEnd() || perItem <= *budget)
+        return {};
+    return {u"%1/%2: %3 over the %4 budget"_s.arg(command, AllocsPerItem).arg(perItem, 0, 'f', 1).arg(*budget)};
+}
+
+qint64 MatBudget::percentile(const QList<qint64> &values, double p)
+{
+    if (values.isEmpty())
+        return 0;
+    const qsizetype rank = qsizetype(p / 100.0 * double(values.size() - 1) + 0.5);
+    return values.at(qBound<qsizetype>(0, rank, values.size() - 1));
+}
@@ -0,0 +1,86 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#ifndef MATBUDGET_H
+#define MATBUDGET_H
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+/*!
+ * \brief The MatBudget class holds the latency budgets of one machine class.
+ *
+ * Budgets live in an INI file, one group per machine class. Keys are
+ * <command>/<statistic>, in milliseconds. The command "all" covers every
+ * invocation and the statistics are p50, p95, p99 and max. allocs-per-item
+ * bounds the mean heap allocations per written record of the batches
+ * instead:
+ *
+ * \code
+ * [laptop]
+ * all/p99=80
+ * defapp/p95=15
+ * def-web-browser/p95=40
+ * mimetype/allocs-per-item=4
+ * \endcode
+ */
+class MatBudget {
+
+public:
+    /*!
+     * \brief load
+     * \param fileName
+     * \param machineClass The group to use
+     * \param errorMessage
+     * \return false if the file can't be read or has no such group
+     */
+    bool load(const QString &fileName, const QString &machineClass, QString *errorMessage);
+
+    /*!
+     * \brief check
+     * \param command The command, or "all"
+     * \param latencies The latencies, in µs, sorted
+     * \return A description of every exceeded budget
+     */
+    QStringList check(const QString &command, const QList<qint64> &latencies) const;
+
+    /*!
+     * \brief checkAllocations
+     * \param command The command, or "all"
+     * \param perItem The mean allocations per record of the batches
+     * \return A description of the exceeded budget, if any
+     */
+    QStringList checkAllocations(const QString &command, double perItem) const;
+
+    /*!
+     * \brief percentile
+     * \param values Sorted values
+     * \param p In [0, 100]
+     * \return The nearest rank percentile, 0 if \a values is empty
+     */
+    static qint64 percentile(const QList<qint64> &values, double p);
+
+private:
+    QHash<QString, QHash<QString, double>> mBudgets; // command -> statistic -> ms
+};
+
+#endif // MATBUDGET_H
@@ -0,0 +1,187 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "matfixture.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStringList>
+
+#include <iterator>
+
+using namespace Qt::Literals::StringLiterals;
+
+namespace {
+
+struct Kind {
+    QLatin1StringView categories;
+    QLatin1StringView mimeTypes;
+};
+
+// What the desktop files cycle through
+const Kind kinds[] = {
+    { "Network;WebBrowser;"_L1, "text/html;x-scheme-handler/http;x-scheme-handler/https;"_L1 },
+    { "Network;Email;"_L1, "x-scheme-handler/mailto;message/rfc822;"_L1 },
+    { "System;FileManager;"_L1, "inode/directory;"_L1 },
+    { "System;TerminalEmulator;"_L1, ""_L1 },
+    { "Utility;TextEditor;"_L1, "text/plain;text/x-csrc;application/json;"_L1 },
+    { "Graphics;Viewer;"_L1, "image/png;image/jpeg;image/svg+xml;"_L1 },
+    { "Office;Viewer;"_L1, "application/pdf;"_L1 }
+};
+
+const struct {
+    QLatin1StringView name;
+    QLatin1StringView contents;
+} samples[] = {
+    { "sample.txt"_L1, "plain text\n"_L1 },
+    { "sample.html"_L1, "<!DOCTYPE html><html><body></body></html>\n"_L1 },
+    { "sample.json"_L1, "{}\n"_L1 },
+    { "sample.c"_L1, "int main(void) { return 0; }\n"_L1 },
+    { "sample.svg"_L1, "<svg xmlns=\"http://www.w3.org/2000/svg\"/>\n"_L1 }
+};
+
+// A globs2 exercising each kind of pattern of the name matcher
+const char globs2[] =
+    "# Generated for qtxdg-mat-replay\n"
+    "50:text/plain:*.txt\n"
+    "50:text/html:*.html\n"
+    "50:application/json:*.json\n"
+    "50:text/x-csrc:*.c\n"
+    "50:text/x-c++src:*.C:cs\n"
+    "50:image/png:*.png\n"
+    "50:image/svg+xml:*.svg\n"
+    "50:application/gzip:*.gz\n"
+    "50:application/x-compressed-tar:*.tar.gz\n"
+    "50:text/x-makefile:makefile\n"
+    "50:text/x-readme:README*\n"
+    "10:text/x-log:*.log.[0-9]\n";
+
+const QLatin1StringView names[] = {
+    "notes.txt"_L1, "INDEX.HTML"_L1, "data.json"_L1, "main.c"_L1, "main.C"_L1, "logo.png"_L1,
+    "icon.svg"_L1, "dump.gz"_L1, "src.tar.gz"_L1, "Makefile"_L1, "README.md"_L1, "app.log.1"_L1,
+    "unknown.bin"_L1
+};
+
+bool writeFile(const QString &fileName, const QByteArray &data, QString *errorMessage)
+{
+    QFile file(fileName);
+    if (!QDir().mkpath(QFileInfo(fileName).path()) || !file.open(QIODevice::WriteOnly | QIODevice::Truncate)
+            || file.write(data) != data.size()) {
+        *errorMessage = u"Could not write %1: %2"_s.arg(fileName, file.errorString());
+        return false;
+    }
+    return true;
+}
+
+QString appId(int index)
+{
+    return u"fixture-app-%1.desktop"_s.arg(index, 4, 10, u'0');
+}
+
+} // namespace
+
+bool MatFixture::generate(const QString &root, int desktopFiles, int repeat, QString *errorMessage)
+{
+    const QString applicationsDir = root + "/usr/share/applications"_L1;
+    const int kindCount = int(std::size(kinds));
+
+    for (int i = 0; i < desktopFiles; ++i) {
+        const Kind &kind = kinds[i % kindCount];
+        QByteArray data = "[Desktop Entry]\nType=Application\n";
+        data += "Name=Fixture App " + QByteArray::number(i) + '\n';
+        data += "Comment=Generated for qtxdg-mat-replay\n";
+        data += "Exec=true %U\n";
+        data += "Categories=" + QByteArray(kind.categories.data(), kind.categories.size()) + '\n';
+        if (!kind.mimeTypes.isEmpty())
+            data += "MimeType=" + QByteArray(kind.mimeTypes.data(), kind.mimeTypes.size()) + '\n';
+        if (!writeFile(applicationsDir + u'/' + appId(i), data, errorMessage))
+            return false;
+    }
+
+    // The user picks the last application of each kind
+    QByteArray mimeApps = "[Default Applications]\n";
+    for (int k = 0; k < kindCount && k < desktopFiles; ++k) {
+        const int last = desktopFiles - 1 - (desktopFiles - 1 - k) % kindCount;
+        const QStringList mimeTypes = QString(kinds[k].mimeTypes).split(u';', Qt::SkipEmptyParts);
+        for (const QString &mimeType : mimeTypes)
+            mimeApps += mimeType.toUtf8() + '=' + appId(last).toUtf8() + ";\n";
+    }
+    if (!writeFile(root + "/home/.config/mimeapps.list"_L1, mimeApps, errorMessage))
+        return false;
+
+    for (const auto &sample : samples) {
+        if (!writeFile(root + "/files/"_L1 + sample.name, QByteArray(sample.contents.data(), sample.contents.size()),
+                       errorMessage)) {
+            return false;
+        }
+    }
+
+    if (!writeFile(root + "/usr/share/mime/globs2"_L1, QByteArray(globs2), errorMessage))
+        return false;
+
+    // The workload, in the QTXDG_MAT_RECORD format
+    QList<QStringList> workload;
+    QStringList defAppBatch{u"defapp"_s};
+    for (const auto &kind : kinds) {
+        const QStringList mimeTypes = QString(kind.mimeTypes).split(u';', Qt::SkipEmptyParts);
+        for (const QString &mimeType : mimeTypes) {
+            workload.append(QStringList{u"defapp"_s, mimeType});
+            workload.append(QStringList{u"defapp"_s, mimeType, u"--format"_s, u"json"_s});
+        }
+        for (int i = 0; i < 50; ++i)
+            defAppBatch.append(mimeTypes);
+    }
+    workload.append(defAppBatch);
+    for (const QString &category : {u"def-web-browser"_s, u"def-email-client"_s, u"def-file-manager"_s, u"def-terminal"_s}) {
+        workload.append(QStringList{category});
+        workload.append(QStringList{category, u"--format"_s, u"json"_s});
+        workload.append(QStringList{category, u"--list-available"_s});
+    }
+    workload.append(QStringList{u"defaults"_s});
+    workload.append(QStringList{u"candidates"_s, u"text/plain"_s, u"text/x-csrc"_s, u"application/json"_s});
+    workload.append(QStringList{u"handles"_s, appId(0)});
+    for (const auto &sample : samples)
+        workload.append(QStringList{u"mimetype"_s, root + "/files/"_L1 + sample.name});
+    QStringList batch{u"mimetype"_s, u"--name-only"_s};
+    for (int i = 0; i < 100; ++i) {
+        for (const QLatin1StringView name : names)
+            batch.append(u"dir%1/"_s.arg(i) + name);
+    }
+    workload.append(batch);
+    workload.append(QStringList{u"check"_s});
+
+    QByteArray log;
+    qint64 time = 0;
+    for (int r = 0; r < repeat; ++r) {
+        for (const QStringList &arguments : std::as_const(workload)) {
+            QJsonObject entry;
+            entry.insert("time"_L1, time++);
+            entry.insert("argv"_L1, QJsonArray::fromStringList(arguments));
+            entry.insert("env"_L1, QJsonObject{{"XDG_CURRENT_DESKTOP"_L1, "LXQt"_L1}});
+            entry.insert("exit"_L1, 0);
+            log += QJsonDocument(entry).toJson(QJsonDocument::Compact) + '\n';
+        }
+    }
+    return writeFile(root + "/workload.jsonl"_L1, log, errorMessage);
+}
@@ -0,0 +1,50 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#ifndef MATFIXTURE_H
+#define MATFIXTURE_H
+
+#include <QString>
+
+/*!
+ * \brief The MatFixture class generates a hermetic XDG tree and a matching
+ * workload log, to be replayed with --xdg-root.
+ *
+ * The tree holds the given number of desktop files, spread over the
+ * categories qtxdg-mat knows, a user mimeapps.list, a small globs2 and a
+ * few sample files.
+ * The workload, written to workload.jsonl at the root, exercises the read
+ * only commands against them.
+ */
+class MatFixture {
+
+public:
+    /*!
+     * \brief generate
+     * \param root The tree root, created if needed
+     * \param desktopFiles The number of desktop files
+     * \param repeat How many times the workload runs each invocation
+     * \param errorMessage
+     * \return false if something couldn't be written
+     */
+    static bool generate(const QString &root, int desktopFiles, int repeat, QString *errorMessage);
+};
+
+#endif // MATFIXTURE_H
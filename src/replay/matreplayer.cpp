@@ -0,0 +1,223 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "matreplayer.h"
+
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QProcess>
+#include <QTimer>
+
+#include <algorithm>
+
+using namespace Qt::Literals::StringLiterals;
+
+// The XDG variables holding paths, and where they go in a hermetic tree
+static const struct {
+    QLatin1StringView name;
+    QLatin1StringView path;
+} xdgPaths[] = {
+    { "XDG_CONFIG_HOME"_L1, "home/.config"_L1 },
+    { "XDG_DATA_HOME"_L1, "home/.local/share"_L1 },
+    { "XDG_STATE_HOME"_L1, "home/.local/state"_L1 },
+    { "XDG_CACHE_HOME"_L1, "home/.cache"_L1 },
+    { "XDG_CONFIG_DIRS"_L1, "etc/xdg"_L1 },
+    { "XDG_DATA_DIRS"_L1, "usr/share"_L1 },
+    { "XDG_RUNTIME_DIR"_L1, "run"_L1 }
+};
+
+MatReplayer::MatReplayer(QObject *parent)
+    : QObject(parent),
+      mProgram(u"qtxdg-mat"_s),
+      mRate(1.0),
+      mClients(1),
+      mFastPath(true),
+      mNext(0),
+      mRunning(0),
+      mScheduleTimer(new QTimer(this)),
+      mElapsed(0)
+{
+    mScheduleTimer->setSingleShot(true);
+    mScheduleTimer->setTimerType(Qt::PreciseTimer);
+    connect(mScheduleTimer, &QTimer::timeout, this, &MatReplayer::schedule);
+}
+
+MatReplayer::~MatReplayer() = default;
+
+bool MatReplayer::load(const QString &fileName, const QStringList &excludedCommands, QString *errorMessage)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        *errorMessage = u"Could not read %1: %2"_s.arg(fileName, file.errorString());
+        return false;
+    }
+
+    mInvocations.clear();
+    while (!file.atEnd()) {
+        const QJsonObject entry = QJsonDocument::fromJson(file.readLine()).object();
+        const QJsonArray argv = entry.value("argv"_L1).toArray();
+        if (argv.isEmpty())
+            continue;
+
+        Invocation invocation;
+        invocation.time = entry.value("time"_L1).toInteger();
+        invocation.recordedWallTime = entry.value("wall_us"_L1).toInteger();
+        invocation.recordedExitCode = entry.value("exit"_L1).toInt();
+        for (const QJsonValue &arg : argv)
+            invocation.arguments.append(arg.toString());
+        const QJsonObject env = entry.value("env"_L1).toObject();
+        for (auto it = env.constBegin(); it != env.constEnd(); ++it)
+            invocation.env.insert(it.key(), it.value().toString());
+
+        if (!excludedCommands.contains(invocation.arguments.constFirst()))
+            mInvocations.append(invocation);
+    }
+
+    // Concurrent invocations may have finished, and logged, out of order
+    std::stable_sort(mInvocations.begin(), mInvocations.end(),
+            [](const Invocation &a, const Invocation &b) { return a.time < b.time; });
+    return true;
+}
+
+void MatReplayer::start()
+{
+    mResults = QList<Result>(mInvocations.size());
+    mNext = 0;
+    mRunning = 0;
+    mTimer.start();
+    schedule();
+}
+
+qint64 MatReplayer::dueTime(qsizetype index) const
+{
+    if (mRate <= 0.0)
+        return 0;
+    const qint64 offset = mInvocations.at(index).time - mInvocations.constFirst().time;
+    return qint64(offset * 1000 / mRate);
+}
+
+void MatReplayer::schedule()
+{
+    while (mNext < mInvocations.size() && mRunning < mClients) {
+        const qint64 wait = dueTime(mNext) - mTimer.nsecsElapsed() / 1000;
+        if (wait > 0) {
+            mScheduleTimer->start(int(qMin<qint64>((wait + 999) / 1000, INT_MAX)));
+            return;
+        }
+        launch(mNext++);
+    }
+
+    if (mNext == mInvocations.size() && mRunning == 0) {
+        mElapsed = mTimer.nsecsElapsed() / 1000;
+        Q_EMIT finished();
+    }
+}
+
+void MatReplayer::launch(qsizetype index)
+{
+    const Invocation &invocation = mInvocations.at(index);
+    Result &result = mResults[index];
+    result.command = invocation.arguments.constFirst();
+    result.lag = qMax<qint64>(0, mTimer.nsecsElapsed() / 1000 - dueTime(index));
+
+    auto *process = new QProcess(this);
+    process->setProgram(mProgram);
+    process->setArguments(invocation.arguments);
+    QProcessEnvironment env = environment(invocation);
+    if (mAllocStatsDir.isValid())
+        env.insert(u"QTXDG_MAT_ALLOC_STATS"_s, mAllocStatsDir.filePath(QString::number(index)));
+    process->setProcessEnvironment(env);
+    process->setStandardInputFile(QProcess::nullDevice());
+    process->setStandardOutputFile(QProcess::nullDevice());
+    process->setStandardErrorFile(QProcess::nullDevice());
+
+    const qint64 startTime = mTimer.nsecsElapsed();
+    connect(process, &QProcess::finished, this, [this, process, index, startTime](int exitCode, QProcess::ExitStatus status) {
+        Result &result = mResults[index];
+        result.latency = (mTimer.nsecsElapsed() - startTime) / 1000;
+        result.exitCodeMatches = status == QProcess::NormalExit
+                && exitCode == mInvocations.at(index).recordedExitCode;
+        readAllocStats(index);
+        process->deleteLater();
+        --mRunning;
+        schedule();
+    });
+    connect(process, &QProcess::errorOccurred, this, [this, process, index](QProcess::ProcessError error) {
+        if (error != QProcess::FailedToStart)
+            return;
+        mResults[index].started = false;
+        process->deleteLater();
+        --mRunning;
+        QTimer::singleShot(0, this, &MatReplayer::schedule);
+    });
+
+    ++mRunning;
+    process->start();
+}
+
+void MatReplayer::readAllocStats(qsizetype index)
+{
+    if (!mAllocStatsDir.isValid())
+        return;
+
+    // "allocations=<n> items=<n>", only written by a counting qtxdg-mat
+    QFile file(mAllocStatsDir.filePath(QString::number(index)));
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+    const QList<QByteArray> fields = file.readAll().trimmed().split(' ');
+    file.remove();
+
+    Result &result = mResults[index];
+    for (const QByteArray &field : fields) {
+        if (field.startsWith("allocations="))
+            result.allocations = field.mid(12).toLongLong();
+        else if (field.startsWith("items="))
+            result.items = field.mid(6).toLongLong();
+    }
+}
+
+QProcessEnvironment MatReplayer::environment(const Invocation &invocation) const
+{
+    QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+    if (!mXdgRoot.isEmpty()) {
+        const QString path = env.value(u"PATH"_s);
+        env.clear();
+        env.insert(u"PATH"_s, path);
+        env.insert(u"HOME"_s, mXdgRoot + "/home"_L1);
+    }
+
+    for (auto it = invocation.env.cbegin(); it != invocation.env.cend(); ++it)
+        env.insert(it.key(), it.value());
+
+    if (!mXdgRoot.isEmpty()) {
+        for (const auto &xdgPath : xdgPaths)
+            env.insert(xdgPath.name, mXdgRoot + u'/' + xdgPath.path);
+    }
+
+    if (!mFastPath)
+        env.insert(u"QTXDG_MAT_NO_FASTPATH"_s, u"1"_s);
+
+    // Never record the replay itself
+    env.remove(u"QTXDG_MAT_RECORD"_s);
+    return env;
+}
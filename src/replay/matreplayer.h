@@ -0,0 +1,168 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#ifndef MATREPLAYER_H
+#define MATREPLAYER_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QProcessEnvironment>
+#include <QString>
+#include <QStringList>
+#include <QTemporaryDir>
+
+class QProcess;
+class QTimer;
+
+/*!
+ * \brief The MatReplayer class replays a QTXDG_MAT_RECORD log.
+ *
+ * The invocations start at their recorded pace, scaled by the rate, with at
+ * most a given number running at once. Their latencies are collected per
+ * command, and their allocations too when qtxdg-mat was built to count them.
+ */
+class MatReplayer : public QObject {
+    Q_OBJECT
+
+public:
+    struct Invocation {
+        qint64 time = 0; //!< ms since the epoch
+        qint64 recordedWallTime = 0; //!< µs
+        int recordedExitCode = 0;
+        QStringList arguments;
+        QHash<QString, QString> env;
+    };
+
+    struct Result {
+        QString command;
+        qint64 latency = 0; //!< µs, from start to exit
+        qint64 lag = 0;     //!< µs, how late it started
+        bool exitCodeMatches = true;
+        bool started = true;
+        qint64 allocations = -1; //!< -1 unless qtxdg-mat counts them
+        qint64 items = 0;        //!< The records it wrote
+    };
+
+    /*!
+     * \brief MatReplayer
+     * \param parent
+     */
+    explicit MatReplayer(QObject *parent = nullptr);
+
+    /*!
+     * \brief ~MatReplayer
+     */
+    ~MatReplayer() override;
+
+    /*!
+     * \brief load
+     * \param fileName The QTXDG_MAT_RECORD log
+     * \param excludedCommands Commands left out, e.g. "open"
+     * \param errorMessage
+     * \return false if the log can't be read. Malformed lines are skipped.
+     */
+    bool load(const QString &fileName, const QStringList &excludedCommands, QString *errorMessage);
+
+    /*!
+     * \brief setProgram
+     * \param program The qtxdg-mat to run
+     */
+    inline void setProgram(const QString &program) { mProgram = program; }
+
+    /*!
+     * \brief setRate
+     * \param rate 1 replays at the recorded pace, 10 ten times faster, 0 as
+     * fast as possible
+     */
+    inline void setRate(double rate) { mRate = rate; }
+
+    /*!
+     * \brief setClients
+     * \param clients The maximum number of invocations running at once
+     */
+    inline void setClients(int clients) { mClients = qMax(1, clients); }
+
+    /*!
+     * \brief setXdgRoot Runs everything against a hermetic XDG tree
+     *
+     * The XDG directories, HOME included, point into \a root and the
+     * environment is cleared but for PATH and the non path XDG_* variables.
+     * \param root
+     */
+    inline void setXdgRoot(const QString &root) { mXdgRoot = root; }
+
+    /*!
+     * \brief setFastPath
+     * \param enabled false runs every invocation with QTXDG_MAT_NO_FASTPATH,
+     * to measure what the qtxdg-mat fast path saves
+     */
+    inline void setFastPath(bool enabled) { mFastPath = enabled; }
+
+    /*!
+     * \brief invocations
+     * \return The loaded invocations, in recorded order
+     */
+    inline const QList<Invocation> &invocations() const { return mInvocations; }
+
+    /*!
+     * \brief start Starts replaying, finished() is emitted at the end
+     */
+    void start();
+
+    /*!
+     * \brief results
+     * \return One result per invocation
+     */
+    inline const QList<Result> &results() const { return mResults; }
+
+    /*!
+     * \brief elapsed
+     * \return The replay duration, in µs
+     */
+    inline qint64 elapsed() const { return mElapsed; }
+
+Q_SIGNALS:
+    void finished();
+
+private:
+    void schedule();
+    void launch(qsizetype index);
+    QProcessEnvironment environment(const Invocation &invocation) const;
+    qint64 dueTime(qsizetype index) const; //!< µs since the start
+    void readAllocStats(qsizetype index);
+
+    QString mProgram;
+    double mRate;
+    int mClients;
+    QString mXdgRoot;
+    bool mFastPath;
+    QList<Invocation> mInvocations;
+    QList<Result> mResults;
+    qsizetype mNext;
+    int mRunning;
+    QElapsedTimer mTimer;
+    QTimer *mScheduleTimer;
+    qint64 mElapsed;
+    QTemporaryDir mAllocStatsDir;
+};
+
+#endif // MATREPLAYER_H
@@ -0,0 +1,288 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "matbudget.h"
+#include "matfixture.h"
+#include "matreplayer.h"
+
+#include <QCommandLineOption>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QMap>
+
+#include <algorithm>
+#include <iostream>
+
+using namespace Qt::Literals::StringLiterals;
+
+// An invocation writing at least this many records is a batch, the
+// allocation budgets apply to those
+static constexpr qint64 MinBatchItems = 100;
+
+// latencies sorted
+static QString latencyLine(const QString &name, const QList<qint64> &latencies)
+{
+    auto ms = [](qint64 us) { return QString::number(double(us) / 1000.0, 'f', 2); };
+    return u"%1 count=%2 p50=%3ms p95=%4ms p99=%5ms max=%6ms"_s
+            .arg(name)
+            .arg(latencies.size())
+            .arg(ms(MatBudget::percentile(latencies, 50)), ms(MatBudget::percentile(latencies, 95)),
+                 ms(MatBudget::percentile(latencies, 99)),
+                 ms(latencies.isEmpty() ? 0 : latencies.constLast()));
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName(u"qtxdg-mat-replay"_s);
+    app.setApplicationVersion(QStringLiteral(QTXDG_TOOLS_VERSION));
+    app.setOrganizationName(u"LXQt"_s);
+    app.setOrganizationDomain(u"lxqt.org"_s);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(u"Replay a qtxdg-mat QTXDG_MAT_RECORD log"_s);
+    parser.addPositionalArgument(u"log"_s, u"The recorded log"_s);
+
+    const QCommandLineOption matOption(QStringList() << u"m"_s << u"mat"_s,
+                u"The qtxdg-mat to run (default: qtxdg-mat)"_s, u"program"_s, u"qtxdg-mat"_s);
+    const QCommandLineOption rateOption(QStringList() << u"r"_s << u"rate"_s,
+                u"Speed factor, 1 is the recorded pace, 0 as fast as possible (default: 1)"_s, u"factor"_s, u"1"_s);
+    const QCommandLineOption clientsOption(QStringList() << u"c"_s << u"clients"_s,
+                u"Invocations running at once (default: 1)"_s, u"count"_s, u"1"_s);
+    const QCommandLineOption xdgRootOption(QStringList() << u"x"_s << u"xdg-root"_s,
+                u"Run against the hermetic XDG tree in directory"_s, u"directory"_s);
+    const QCommandLineOption noFastPathOption(QStringList() << u"no-fastpath"_s,
+                u"Run every invocation through the full application startup"_s);
+    const QCommandLineOption compareFastPathOption(QStringList() << u"compare-fastpath"_s,
+                u"Replay the log a second time through the full application startup and compare "
+                u"the latencies of both runs"_s);
+    const QCommandLineOption excludeOption(QStringList() << u"e"_s << u"exclude"_s,
+                u"Skip the invocations of command, e.g. open. Can be repeated."_s, u"command"_s);
+
+    const QCommandLineOption budgetOption(QStringList() << u"b"_s << u"budget"_s,
+                u"Exit with 1 if a latency exceeds the budgets in file"_s, u"file"_s);
+    const QCommandLineOption machineClassOption(QStringList() << u"machine-class"_s,
+                u"The budgets group to use (default: $QTXDG_MAT_MACHINE_CLASS or \"default\")"_s, u"name"_s);
+    const QCommandLineOption generateOption(QStringList() << u"generate-fixture"_s,
+                u"Generate an XDG tree and its workload.jsonl in directory, then exit"_s, u"directory"_s);
+    const QCommandLineOption desktopFilesOption(QStringList() << u"desktop-files"_s,
+                u"Desktop files in the generated tree (default: 3000)"_s, u"count"_s, u"3000"_s);
+    const QCommandLineOption repeatOption(QStringList() << u"repeat"_s,
+                u"Repetitions of the generated workload (default: 10)"_s, u"count"_s, u"10"_s);
+
+    parser.addOption(matOption);
+    parser.addOption(rateOption);
+    parser.addOption(clientsOption);
+    parser.addOption(xdgRootOption);
+    parser.addOption(noFastPathOption);
+    parser.addOption(compareFastPathOption);
+    parser.addOption(excludeOption);
+    parser.addOption(budgetOption);
+    parser.addOption(machineClassOption);
+    parser.addOption(generateOption);
+    parser.addOption(desktopFilesOption);
+    parser.addOption(repeatOption);
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.process(app);
+
+    bool ok = false;
+    QString errorMessage;
+
+    if (parser.isSet(generateOption)) {
+        const int desktopFiles = parser.value(desktopFilesOption).toInt(&ok);
+        const int repeat = ok ? parser.value(repeatOption).toInt(&ok) : 0;
+        if (!ok || desktopFiles < 1 || repeat < 1) {
+            std::cerr << "Invalid desktop file or repetition count\n";
+            return EXIT_FAILURE;
+        }
+        if (!MatFixture::generate(parser.value(generateOption), desktopFiles, repeat, &errorMessage)) {
+            std::cerr << qPrintable(errorMessage) << '\n';
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    MatBudget budget;
+    const bool hasBudget = parser.isSet(budgetOption);
+    if (hasBudget) {
+        QString machineClass = parser.value(machineClassOption);
+        if (machineClass.isEmpty())
+            machineClass = qEnvironmentVariable("QTXDG_MAT_MACHINE_CLASS", u"default"_s);
+        if (!budget.load(parser.value(budgetOption), machineClass, &errorMessage)) {
+            std::cerr << qPrintable(errorMessage) << '\n';
+            return EXIT_FAILURE;
+        }
+    }
+
+    const QStringList posArgs = parser.positionalArguments();
+    if (posArgs.size() != 1) {
+        std::cerr << "One log, please\n\n" << qPrintable(parser.helpText());
+        return EXIT_FAILURE;
+    }
+
+    const double rate = parser.value(rateOption).toDouble(&ok);
+    if (!ok || rate < 0) {
+        std::cerr << qPrintable(u"Invalid rate: %1\n"_s.arg(parser.value(rateOption)));
+        return EXIT_FAILURE;
+    }
+    const int clients = parser.value(clientsOption).toInt(&ok);
+    if (!ok || clients < 1) {
+        std::cerr << qPrintable(u"Invalid client count: %1\n"_s.arg(parser.value(clientsOption)));
+        return EXIT_FAILURE;
+    }
+
+    const bool compareFastPath = parser.isSet(compareFastPathOption);
+    if (compareFastPath && parser.isSet(noFastPathOption)) {
+        std::cerr << "--compare-fastpath already replays without the fast path\n";
+        return EXIT_FAILURE;
+    }
+
+    auto replay = [&](MatReplayer *replayer, bool fastPath) {
+        if (!replayer->load(posArgs.constFirst(), parser.values(excludeOption), &errorMessage))
+            return false;
+        replayer->setProgram(parser.value(matOption));
+        replayer->setRate(rate);
+        replayer->setClients(clients);
+        replayer->setXdgRoot(parser.value(xdgRootOption));
+        replayer->setFastPath(fastPath);
+
+        QObject::connect(replayer, &MatReplayer::finished, &app, &QCoreApplication::quit, Qt::QueuedConnection);
+        replayer->start();
+        app.exec();
+        return true;
+    };
+
+    MatReplayer replayer;
+    if (!replay(&replayer, !parser.isSet(noFastPathOption))) {
+        std::cerr << qPrintable(errorMessage) << '\n';
+        return EXIT_FAILURE;
+    }
+
+    // The same log through the full startup, the budgets only apply to the
+    // first run
+    QMap<QString, QList<qint64>> fullByCommand;
+    if (compareFastPath) {
+        MatReplayer fullReplayer;
+        if (!replay(&fullReplayer, false)) {
+            std::cerr << qPrintable(errorMessage) << '\n';
+            return EXIT_FAILURE;
+        }
+        for (const MatReplayer::Result &result : fullReplayer.results()) {
+            if (result.started)
+                fullByCommand[result.command].append(result.latency);
+        }
+        for (auto it = fullByCommand.begin(); it != fullByCommand.end(); ++it)
+            std::sort(it->begin(), it->end());
+    }
+
+    QList<qint64> all;
+    QList<qint64> lags;
+    QMap<QString, QList<qint64>> byCommand;
+    struct Allocations {
+        qint64 invocations = 0;
+        qint64 allocations = 0;
+        qint64 batchAllocations = 0; //!< Of the invocations writing MinBatchItems records or more
+        qint64 batchItems = 0;
+    };
+    QMap<QString, Allocations> allocationsByCommand; // "all" included
+    int notStarted = 0;
+    int mismatches = 0;
+    const QList<MatReplayer::Result> &results = replayer.results();
+    for (const MatReplayer::Result &result : results) {
+        if (!result.started) {
+            ++notStarted;
+            continue;
+        }
+        if (!result.exitCodeMatches)
+            ++mismatches;
+        all.append(result.latency);
+        lags.append(result.lag);
+        byCommand[result.command].append(result.latency);
+        if (result.allocations >= 0) {
+            for (const QString &command : {result.command, u"all"_s}) {
+                Allocations &a = allocationsByCommand[command];
+                ++a.invocations;
+                a.allocations += result.allocations;
+                if (result.items >= MinBatchItems) {
+                    a.batchAllocations += result.allocations;
+                    a.batchItems += result.items;
+                }
+            }
+        }
+    }
+
+    // Over the batches only, where the per item cost isn't hidden by the
+    // process startup. -1 without a batch.
+    auto perItem = [](const Allocations &a) {
+        return a.batchItems > 0 ? double(a.batchAllocations) / double(a.batchItems) : -1.0;
+    };
+
+    std::sort(all.begin(), all.end());
+    std::sort(lags.begin(), lags.end());
+    for (auto it = byCommand.begin(); it != byCommand.end(); ++it)
+        std::sort(it->begin(), it->end());
+
+    const double seconds = double(replayer.elapsed()) / 1e6;
+    std::cout << qPrintable(u"invocations=%1 elapsed=%2s throughput=%3/s failed-to-start=%4 exit-code-mismatches=%5\n"_s
+                            .arg(all.size())
+                            .arg(seconds, 0, 'f', 3)
+                            .arg(seconds > 0 ? double(all.size()) / seconds : 0.0, 0, 'f', 1)
+                            .arg(notStarted)
+                            .arg(mismatches));
+    std::cout << qPrintable(latencyLine(u"latency"_s, all)) << '\n';
+    std::cout << qPrintable(latencyLine(u"start-lag"_s, lags)) << '\n';
+    for (auto it = byCommand.cbegin(); it != byCommand.cend(); ++it)
+        std::cout << qPrintable(latencyLine(u"latency[%1]"_s.arg(it.key()), it.value())) << '\n';
+    for (auto it = fullByCommand.cbegin(); it != fullByCommand.cend(); ++it) {
+        const qint64 fast = MatBudget::percentile(byCommand.value(it.key()), 50);
+        const qint64 full = MatBudget::percentile(it.value(), 50);
+        std::cout << qPrintable(u"cold-start[%1] p50=%2ms full-startup-p50=%3ms saved=%4ms"_s
+                                .arg(it.key())
+                                .arg(double(fast) / 1000.0, 0, 'f', 2)
+                                .arg(double(full) / 1000.0, 0, 'f', 2)
+                                .arg(double(full - fast) / 1000.0, 0, 'f', 2)) << '\n';
+    }
+    for (auto it = allocationsByCommand.cbegin(); it != allocationsByCommand.cend(); ++it) {
+        std::cout << qPrintable(u"allocations[%1] count=%2 per-invocation=%3 per-item=%4"_s
+                                .arg(it.key())
+                                .arg(it->invocations)
+                                .arg(double(it->allocations) / double(it->invocations), 0, 'f', 1)
+                                .arg(perItem(*it) < 0 ? u"n/a"_s : QString::number(perItem(*it), 'f', 1))) << '\n';
+    }
+
+    if (notStarted != 0)
+        return EXIT_FAILURE;
+
+    if (hasBudget) {
+        QStringList violations = budget.check(u"all"_s, all);
+        for (auto it = byCommand.cbegin(); it != byCommand.cend(); ++it)
+            violations.append(budget.check(it.key(), it.value()));
+        for (auto it = allocationsByCommand.cbegin(); it != allocationsByCommand.cend(); ++it) {
+            if (perItem(*it) >= 0)
+                violations.append(budget.checkAllocations(it.key(), perItem(*it)));
+        }
+        for (const QString &violation : std::as_const(violations))
+            std::cerr << qPrintable(u"Budget exceeded: "_s + violation) << '\n';
+        if (!violations.isEmpty())
+            return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,271 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+
+#include "matdbusactivation.h"
+
+#include <QDBusConnection>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QProcess>
+#include <QProcessEnvironment>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QThread>
+#include <QUrl>
+#include <QVariantMap>
+
+#include <utility>
+
+using namespace Qt::Literals::StringLiterals;
+
+static constexpr QLatin1StringView ServiceName("org.lxqt.MatTest");
+static constexpr QLatin1StringView DesktopId("org.lxqt.MatTest.desktop");
+
+/*
+ * A running DBusActivatable application, remembering its calls. It lives in
+ * a thread of its own, the calls under test block the main one.
+ */
+class FakeApplication : public QObject {
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.freedesktop.Application")
+
+public:
+    struct Call {
+        QString method;
+        QStringList uris;
+        QVariantMap platformData;
+    };
+
+    QList<Call> takeCalls()
+    {
+        QMutexLocker locker(&mMutex);
+        return std::exchange(mCalls, {});
+    }
+
+public Q_SLOTS:
+    void Activate(const QVariantMap &platformData)
+    {
+        record(Call{u"Activate"_s, {}, platformData});
+    }
+
+    void Open(const QStringList &uris, const QVariantMap &platformData)
+    {
+        record(Call{u"Open"_s, uris, platformData});
+    }
+
+private:
+    void record(const Call &call)
+    {
+        QMutexLocker locker(&mMutex);
+        mCalls.append(call);
+    }
+
+    QMutex mMutex;
+    QList<Call> mCalls;
+};
+
+class tst_MatDBusActivation : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+    void init();
+    void open();
+    void activate();
+    void platformData();
+    void noService();
+    void objectPath();
+    void openCommand();
+    void openBatching();
+
+private:
+    static bool writeFile(const QString &fileName, const QByteArray &data);
+    bool runMat(const QString &workingDirectory, const QStringList &arguments);
+
+    QTemporaryDir mRoot;
+    QThread mThread;
+    FakeApplication *mApp = nullptr;
+};
+
+bool tst_MatDBusActivation::writeFile(const QString &fileName, const QByteArray &data)
+{
+    QFile file(fileName);
+    return QDir().mkpath(QFileInfo(fileName).absolutePath()) && file.open(QIODevice::WriteOnly)
+            && file.write(data) == data.size();
+}
+
+bool tst_MatDBusActivation::runMat(const QString &workingDirectory, const QStringList &arguments)
+{
+    // Our application is the default for text/plain and the http, https and
+    // mailto schemes, and only D-Bus tells
+    // whether it got the files, its Exec does nothing
+    QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
+    environment.insert(u"XDG_DATA_HOME"_s, mRoot.path() + "/data"_L1);
+    environment.insert(u"XDG_CONFIG_HOME"_s, mRoot.path() + "/config"_L1);
+    environment.remove(u"QTXDG_MAT_SOCKET"_s);
+    environment.remove(u"QTXDG_MAT_RECORD"_s);
+
+    QProcess mat;
+    mat.setProcessEnvironment(environment);
+    mat.setWorkingDirectory(workingDirectory);
+    mat.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+    mat.start(QStringLiteral(QTXDG_MAT_PROGRAM), arguments);
+    return mat.waitForFinished(60 * 1000) && mat.exitStatus() == QProcess::NormalExit && mat.exitCode() == 0;
+}
+
+void tst_MatDBusActivation::initTestCase()
+{
+    if (!QDBusConnection::sessionBus().isConnected())
+        QSKIP("No session bus, run it through dbus-run-session");
+
+    QVERIFY(mRoot.isValid());
+    QVERIFY(writeFile(mRoot.path() + "/data/applications/"_L1 + DesktopId,
+                      "[Desktop Entry]\nType=Application\nName=Mat Test\nExec=true %U\n"
+                      "MimeType=text/plain;\nDBusActivatable=true\n"));
+    const QByteArray id(DesktopId.data(), DesktopId.size());
+    QByteArray mimeApps = "[Default Applications]\n";
+    for (const char *mimeType : {"text/plain", "x-scheme-handler/http", "x-scheme-handler/https", "x-scheme-handler/mailto"})
+        mimeApps += QByteArray(mimeType) + '=' + id + ";\n";
+    QVERIFY(writeFile(mRoot.path() + "/config/mimeapps.list"_L1, mimeApps));
+
+    mApp = new FakeApplication;
+    mApp->moveToThread(&mThread);
+    mThread.start();
+
+    QDBusConnection service = QDBusConnection::connectToBus(QDBusConnection::SessionBus, u"fake-application"_s);
+    QVERIFY(service.isConnected());
+    QVERIFY(service.registerObject(MatDBusActivation::objectPath(ServiceName), mApp, QDBusConnection::ExportAllSlots));
+    QVERIFY(service.registerService(ServiceName));
+}
+
+void tst_MatDBusActivation::cleanupTestCase()
+{
+    QDBusConnection::disconnectFromBus(u"fake-application"_s);
+    mThread.quit();
+    mThread.wait();
+    delete mApp;
+}
+
+void tst_MatDBusActivation::init()
+{
+    mApp->takeCalls();
+}
+
+void tst_MatDBusActivation::open()
+{
+    const QList<QUrl> urls{QUrl::fromLocalFile(u"/tmp/a b.txt"_s), QUrl(u"https://lxqt-project.org/?q=a b"_s)};
+    QVERIFY(MatDBusActivation::open(DesktopId, urls));
+
+    const QList<FakeApplication::Call> calls = mApp->takeCalls();
+    QCOMPARE(calls.size(), 1);
+    QCOMPARE(calls.at(0).method, u"Open"_s);
+    QCOMPARE(calls.at(0).uris, QStringList({u"file:///tmp/a%20b.txt"_s, u"https://lxqt-project.org/?q=a%20b"_s}));
+}
+
+void tst_MatDBusActivation::activate()
+{
+    QVERIFY(MatDBusActivation::open(DesktopId, QList<QUrl>()));
+
+    const QList<FakeApplication::Call> calls = mApp->takeCalls();
+    QCOMPARE(calls.size(), 1);
+    QCOMPARE(calls.at(0).method, u"Activate"_s);
+}
+
+void tst_MatDBusActivation::platformData()
+{
+    qputenv("DESKTOP_STARTUP_ID", "mat-test_TIME0");
+    const bool opened = MatDBusActivation::open(DesktopId, QList<QUrl>());
+    qunsetenv("DESKTOP_STARTUP_ID");
+    QVERIFY(opened);
+
+    const QList<FakeApplication::Call> calls = mApp->takeCalls();
+    QCOMPARE(calls.size(), 1);
+    QCOMPARE(calls.at(0).platformData.value(u"desktop-startup-id"_s).toString(), u"mat-test_TIME0"_s);
+}
+
+void tst_MatDBusActivation::noService()
+{
+    const QList<QUrl> urls{QUrl::fromLocalFile(u"/tmp/a.txt"_s)};
+    QVERIFY(!MatDBusActivation::open(u"org.lxqt.MatTest.Missing.desktop"_s, urls));
+    QVERIFY(!MatDBusActivation::open(u".desktop"_s, urls));
+    QVERIFY(mApp->takeCalls().isEmpty());
+}
+
+void tst_MatDBusActivation::objectPath()
+{
+    QCOMPARE(MatDBusActivation::objectPath(u"org.example.my-app"_s), u"/org/example/my_app"_s);
+}
+
+void tst_MatDBusActivation::openCommand()
+{
+    // The application runs elsewhere, relative paths and files named like
+    // URLs have to reach it as absolute file URLs
+    QTemporaryDir work;
+    QVERIFY(work.isValid());
+    const QString dir = QDir(work.path()).canonicalPath();
+    QVERIFY(writeFile(dir + "/notes.txt"_L1, "notes\n"));
+    QVERIFY(writeFile(dir + "/ab:c.txt"_L1, "not a URL\n"));
+
+    QVERIFY(runMat(dir, {u"open"_s, u"notes.txt"_s, u"ab:c.txt"_s}));
+
+    const QList<FakeApplication::Call> calls = mApp->takeCalls();
+    QCOMPARE(calls.size(), 1);
+    QCOMPARE(calls.at(0).method, u"Open"_s);
+    QCOMPARE(calls.at(0).uris, QStringList({QUrl::fromLocalFile(dir + "/notes.txt"_L1).toString(QUrl::FullyEncoded),
+                                            QUrl::fromLocalFile(dir + "/ab:c.txt"_L1).toString(QUrl::FullyEncoded)}));
+}
+
+void tst_MatDBusActivation::openBatching()
+{
+    // Files and URLs of the same application go in one call, in order
+    QTemporaryDir work;
+    QVERIFY(work.isValid());
+    const QString dir = QDir(work.path()).canonicalPath();
+    QVERIFY(writeFile(dir + "/notes.txt"_L1, "notes\n"));
+    QVERIFY(writeFile(dir + "/sub/todo.txt"_L1, "todo\n"));
+
+    QStringList arguments{u"open"_s, u"notes.txt"_s, u"mailto:someone@example.org"_s, u"HTTP://lxqt-project.org/"_s};
+    QStringList uris{QUrl::fromLocalFile(dir + "/notes.txt"_L1).toString(QUrl::FullyEncoded),
+                     u"mailto:someone@example.org"_s, u"http://lxqt-project.org/"_s};
+    for (int i = 0; i < 20; ++i) {
+        arguments.append(u"https://lxqt-project.org/%1"_s.arg(i));
+        uris.append(u"https://lxqt-project.org/%1"_s.arg(i));
+    }
+    arguments.append(u"sub/todo.txt"_s);
+    uris.append(QUrl::fromLocalFile(dir + "/sub/todo.txt"_L1).toString(QUrl::FullyEncoded));
+    arguments.append(dir + "/notes.txt"_L1);
+    uris.append(QUrl::fromLocalFile(dir + "/notes.txt"_L1).toString(QUrl::FullyEncoded));
+
+    QVERIFY(runMat(dir, arguments));
+
+    const QList<FakeApplication::Call> calls = mApp->takeCalls();
+    QCOMPARE(calls.size(), 1);
+    QCOMPARE(calls.at(0).method, u"Open"_s);
+    QCOMPARE(calls.at(0).uris, uris);
+}
+
+QTEST_GUILESS_MAIN(tst_MatDBusActivation)
+
+#include "tst_matdbusactivation.moc"
@@ -0,0 +1,163 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+#include "matfileprobe.h"
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <cerrno>
+
+#include <sys/stat.h>
+
+using namespace Qt::Literals::StringLiterals;
+
+class tst_MatFileProbe : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void threads();
+    void ringMatchesThreads();
+    void singleEntry();
+
+private:
+    static constexpr qsizetype HeaderSize = 16;
+
+    static bool writeFile(const QString &fileName, const QByteArray &data);
+    QList<MatFileProbe::Entry> entries() const;
+    QList<MatFileProbe::Entry> probe(bool ring, QByteArray *backend) const;
+
+    QTemporaryDir mRoot;
+};
+
+bool tst_MatFileProbe::writeFile(const QString &fileName, const QByteArray &data)
+{
+    QFile file(fileName);
+    return file.open(QIODevice::WriteOnly) && file.write(data) == data.size();
+}
+
+// More entries than the queue depth of probe(), so the slots are reused
+QList<MatFileProbe::Entry> tst_MatFileProbe::entries() const
+{
+    const QStringList names{u"long"_s, u"short"_s, u"empty"_s, u"dir"_s, u"missing"_s, u"short/child"_s,
+                            u"long"_s};
+    QList<MatFileProbe::Entry> list;
+    for (const QString &name : names) {
+        MatFileProbe::Entry entry;
+        entry.path = QFile::encodeName(mRoot.path() + u'/' + name);
+        list.append(entry);
+    }
+    return list;
+}
+
+QList<MatFileProbe::Entry> tst_MatFileProbe::probe(bool ring, QByteArray *backend) const
+{
+    if (ring)
+        qunsetenv("QTXDG_MAT_NO_IO_URING");
+    else
+        qputenv("QTXDG_MAT_NO_IO_URING", "1");
+
+    MatFileProbe probe(4, HeaderSize);
+    QList<MatFileProbe::Entry> list = entries();
+    probe.run(&list);
+    // Again over the same entries, as mimetype does between its batches
+    probe.run(&list);
+    *backend = probe.backend();
+
+    qunsetenv("QTXDG_MAT_NO_IO_URING");
+    return list;
+}
+
+void tst_MatFileProbe::initTestCase()
+{
+    QVERIFY(mRoot.isValid());
+    QVERIFY(writeFile(mRoot.path() + "/long"_L1, QByteArray("0123456789abcdefghijklmnopqrstuvwxyz")));
+    QVERIFY(writeFile(mRoot.path() + "/short"_L1, QByteArray("short")));
+    QVERIFY(writeFile(mRoot.path() + "/empty"_L1, QByteArray()));
+    QVERIFY(QDir(mRoot.path()).mkdir(u"dir"_s));
+}
+
+void tst_MatFileProbe::threads()
+{
+    QByteArray backend;
+    const QList<MatFileProbe::Entry> list = probe(false, &backend);
+    QCOMPARE(backend, QByteArray("threads"));
+    QCOMPARE(list.size(), 7);
+
+    QCOMPARE(list.at(0).error, 0);
+    QVERIFY(S_ISREG(list.at(0).mode));
+    QCOMPARE(list.at(0).header, QByteArray("0123456789abcdef"));
+
+    QCOMPARE(list.at(1).error, 0);
+    QCOMPARE(list.at(1).header, QByteArray("short"));
+
+    QCOMPARE(list.at(2).error, 0);
+    QVERIFY(S_ISREG(list.at(2).mode));
+    QVERIFY(list.at(2).header.isEmpty());
+
+    // Not a regular file, nothing is read
+    QCOMPARE(list.at(3).error, 0);
+    QVERIFY(S_ISDIR(list.at(3).mode));
+    QVERIFY(list.at(3).header.isEmpty());
+
+    QCOMPARE(list.at(4).error, ENOENT);
+    QCOMPARE(list.at(4).mode, 0u);
+    QVERIFY(list.at(4).header.isEmpty());
+
+    QCOMPARE(list.at(5).error, ENOTDIR);
+
+    QCOMPARE(list.at(6).header, list.at(0).header);
+}
+
+void tst_MatFileProbe::ringMatchesThreads()
+{
+    QByteArray threadsBackend;
+    const QList<MatFileProbe::Entry> expected = probe(false, &threadsBackend);
+    QByteArray ringBackend;
+    const QList<MatFileProbe::Entry> actual = probe(true, &ringBackend);
+    if (ringBackend != "io_uring")
+        qInfo("No io_uring here, the threads are compared with themselves");
+
+    QCOMPARE(actual.size(), expected.size());
+    for (qsizetype i = 0; i < expected.size(); ++i) {
+        QCOMPARE(actual.at(i).path, expected.at(i).path);
+        QCOMPARE(actual.at(i).error, expected.at(i).error);
+        QCOMPARE(actual.at(i).mode, expected.at(i).mode);
+        QCOMPARE(actual.at(i).header, expected.at(i).header);
+    }
+}
+
+void tst_MatFileProbe::singleEntry()
+{
+    // A single file doesn't set the ring up
+    qunsetenv("QTXDG_MAT_NO_IO_URING");
+    MatFileProbe probe(4, HeaderSize);
+    QList<MatFileProbe::Entry> list = entries().mid(0, 1);
+    probe.run(&list);
+    QCOMPARE(QByteArray(probe.backend()), QByteArray("threads"));
+    QCOMPARE(list.at(0).header, QByteArray("0123456789abcdef"));
+}
+
+QTEST_GUILESS_MAIN(tst_MatFileProbe)
+
+#include "tst_matfileprobe.moc"
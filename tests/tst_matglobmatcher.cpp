@@ -0,0 +1,139 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+
+#include "matglobmatcher.h"
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+
+using namespace Qt::Literals::StringLiterals;
+
+class tst_MatGlobMatcher : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void match_data();
+    void match();
+    void weight();
+    void noGlobs();
+    void noGlobsFile();
+
+private:
+    static bool writeGlobs(const QString &dir, const QByteArray &globs2);
+};
+
+bool tst_MatGlobMatcher::writeGlobs(const QString &dir, const QByteArray &globs2)
+{
+    QFile file(dir + "/globs2"_L1);
+    return QDir().mkpath(dir) && file.open(QIODevice::WriteOnly) && file.write(globs2) == globs2.size();
+}
+
+void tst_MatGlobMatcher::match_data()
+{
+    QTest::addColumn<QString>("fileName");
+    QTest::addColumn<QString>("mimeType");
+
+    QTest::newRow("suffix") << u"notes.txt"_s << u"text/plain"_s;
+    QTest::newRow("directories") << u"/home/user/notes.txt"_s << u"text/plain"_s;
+    QTest::newRow("case folded") << u"INDEX.HTML"_s << u"text/html"_s;
+    QTest::newRow("case sensitive") << u"main.C"_s << u"text/x-c++src"_s;
+    QTest::newRow("case sensitive, other case") << u"main.c"_s << u"text/x-csrc"_s;
+    QTest::newRow("case sensitive, other case folded") << u"MAIN.c"_s << u"text/x-csrc"_s;
+    QTest::newRow("longest pattern") << u"src.tar.gz"_s << u"application/x-compressed-tar"_s;
+    QTest::newRow("shorter pattern") << u"dump.gz"_s << u"application/gzip"_s;
+    QTest::newRow("literal") << u"Makefile"_s << u"text/x-makefile"_s;
+    QTest::newRow("literal, whole name only") << u"GNUmakefile"_s << QString();
+    QTest::newRow("fnmatch") << u"README.md"_s << u"text/x-readme"_s;
+    QTest::newRow("fnmatch, bracket") << u"app.log.1"_s << u"text/x-log"_s;
+    QTest::newRow("no match") << u"unknown.bin"_s << QString();
+    QTest::newRow("directory only") << u"dir/"_s << QString();
+}
+
+void tst_MatGlobMatcher::match()
+{
+    QFETCH(QString, fileName);
+    QFETCH(QString, mimeType);
+
+    QTemporaryDir root;
+    QVERIFY(root.isValid());
+    QVERIFY(writeGlobs(root.path() + "/mime"_L1,
+                       "# comment\n"
+                       "50:text/plain:*.txt\n"
+                       "50:text/html:*.html\n"
+                       "50:text/x-csrc:*.c\n"
+                       "50:text/x-c++src:*.C:cs\n"
+                       "50:application/gzip:*.gz\n"
+                       "50:application/x-compressed-tar:*.tar.gz\n"
+                       "50:text/x-makefile:makefile\n"
+                       "50:text/x-readme:README*\n"
+                       "10:text/x-log:*.log.[0-9]\n"));
+
+    MatGlobMatcher matcher;
+    QVERIFY(matcher.load({root.path() + "/mime"_L1}));
+    QCOMPARE(matcher.match(fileName).toString(), mimeType);
+}
+
+void tst_MatGlobMatcher::weight()
+{
+    QTemporaryDir root;
+    QVERIFY(root.isValid());
+    // The weight beats the longer pattern
+    QVERIFY(writeGlobs(root.path() + "/mime"_L1,
+                       "80:text/x-patch:*.diff\n"
+                       "50:text/x-other:*.x.diff\n"));
+
+    MatGlobMatcher matcher;
+    QVERIFY(matcher.load({root.path() + "/mime"_L1}));
+    QCOMPARE(matcher.match(u"a.x.diff").toString(), u"text/x-patch"_s);
+}
+
+void tst_MatGlobMatcher::noGlobs()
+{
+    QTemporaryDir root;
+    QVERIFY(root.isValid());
+    const QString user = root.path() + "/user/mime"_L1;
+    const QString system = root.path() + "/system/mime"_L1;
+    QVERIFY(writeGlobs(user, "50:text/x-foo:__NOGLOBS__\n50:text/x-bar:*.bar\n"));
+    QVERIFY(writeGlobs(system, "50:text/x-foo:*.foo\n50:text/x-baz:*.baz\n"));
+
+    MatGlobMatcher matcher;
+    QVERIFY(matcher.load({user, system}));
+    QCOMPARE(matcher.match(u"a.foo").toString(), QString());
+    QCOMPARE(matcher.match(u"a.bar").toString(), u"text/x-bar"_s);
+    QCOMPARE(matcher.match(u"a.baz").toString(), u"text/x-baz"_s);
+}
+
+void tst_MatGlobMatcher::noGlobsFile()
+{
+    QTemporaryDir root;
+    QVERIFY(root.isValid());
+
+    MatGlobMatcher matcher;
+    QVERIFY(!matcher.load({root.path() + "/mime"_L1}));
+    QVERIFY(matcher.isEmpty());
+    QCOMPARE(matcher.match(u"notes.txt").toString(), QString());
+}
+
+QTEST_GUILESS_MAIN(tst_MatGlobMatcher)
+
+#include "tst_matglobmatcher.moc"
@@ -0,0 +1,96 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+
+#include "matlinereader.h"
+
+#include <QStringList>
+#include <QTest>
+
+#include <cstdio>
+
+using namespace Qt::Literals::StringLiterals;
+
+class tst_MatLineReader : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void lines();
+    void nulSeparated();
+    void longRecord();
+    void utf8();
+
+private:
+    static QStringList readAll(const QByteArray &data, char delimiter);
+};
+
+QStringList tst_MatLineReader::readAll(const QByteArray &data, char delimiter)
+{
+    FILE *stream = std::tmpfile();
+    if (stream == nullptr)
+        return {u"tmpfile() failed"_s};
+    std::fwrite(data.constData(), 1, size_t(data.size()), stream);
+    std::rewind(stream);
+
+    QStringList records;
+    MatLineReader reader(stream, delimiter);
+    QString record;
+    while (reader.next(&record))
+        records.append(record);
+    if (reader.hasError())
+        records.append(u"read error"_s);
+    std::fclose(stream);
+    return records;
+}
+
+void tst_MatLineReader::lines()
+{
+    QCOMPARE(readAll("a\nb\r\n\nc", '\n'), QStringList({u"a"_s, u"b"_s, QString(), u"c"_s}));
+    QCOMPARE(readAll("a\n", '\n'), QStringList({u"a"_s}));
+    QCOMPARE(readAll("", '\n'), QStringList());
+}
+
+void tst_MatLineReader::nulSeparated()
+{
+    // Only the delimiter splits, a '\r' or '\n' is part of the record
+    const QByteArray data("a\nb\0c\r\0\0d", 9);
+    QCOMPARE(readAll(data, '\0'), QStringList({u"a\nb"_s, u"c\r"_s, QString(), u"d"_s}));
+}
+
+void tst_MatLineReader::longRecord()
+{
+    // Spans several blocks, the buffer has to grow
+    const QByteArray longLine(200 * 1024, 'x');
+    const QStringList records = readAll("short\n" + longLine + "\nlast\n", '\n');
+    QCOMPARE(records.size(), 3);
+    QCOMPARE(records.at(0), u"short"_s);
+    QCOMPARE(records.at(1), QString::fromLatin1(longLine));
+    QCOMPARE(records.at(2), u"last"_s);
+}
+
+void tst_MatLineReader::utf8()
+{
+    const QString text = u"text/plain;charset=é中\U0001F600"_s;
+    QCOMPARE(readAll(text.toUtf8() + '\n' + text.toUtf8(), '\n'), QStringList({text, text}));
+}
+
+QTEST_GUILESS_MAIN(tst_MatLineReader)
+
+#include "tst_matlinereader.moc"
@@ -0,0 +1,191 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+
+#include "matmimeappslist.h"
+#include "matmimeappswriter.h"
+
+#include <QFile>
+#include <QScopedPointer>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+
+using namespace Qt::Literals::StringLiterals;
+
+class tst_MatMimeAppsWriter : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void init();
+    void newFile();
+    void keepsTheRest();
+    void removeEntry();
+    void unchanged();
+    void lock();
+
+private:
+    static bool writeFile(const QString &fileName, const QByteArray &data);
+    static QByteArray readFile(const QString &fileName);
+    bool isLocked() const;
+
+    QScopedPointer<QTemporaryDir> mDir;
+    QString mFileName;
+};
+
+bool tst_MatMimeAppsWriter::writeFile(const QString &fileName, const QByteArray &data)
+{
+    QFile file(fileName);
+    return file.open(QIODevice::WriteOnly) && file.write(data) == data.size();
+}
+
+QByteArray tst_MatMimeAppsWriter::readFile(const QString &fileName)
+{
+    QFile file(fileName);
+    return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+}
+
+bool tst_MatMimeAppsWriter::isLocked() const
+{
+    // flock() locks belong to the open file, another one conflicts even in
+    // the same process
+    const QByteArray lockFileName = QFile::encodeName(mDir->path() + "/.mimeapps.list.lock"_L1);
+    const int fd = ::open(lockFileName.constData(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (fd < 0)
+        return false;
+    const bool locked = ::flock(fd, LOCK_EX | LOCK_NB) < 0 && errno == EWOULDBLOCK;
+    ::close(fd);
+    return locked;
+}
+
+void tst_MatMimeAppsWriter::init()
+{
+    mDir.reset(new QTemporaryDir);
+    QVERIFY(mDir->isValid());
+    mFileName = mDir->path() + "/mimeapps.list"_L1;
+}
+
+void tst_MatMimeAppsWriter::newFile()
+{
+    MatMimeAppsWriter writer(mFileName);
+    writer.setDefaultApp(u"text/plain"_s, u"editor.desktop"_s);
+    QString errorMessage;
+    QVERIFY2(writer.commit(&errorMessage), qPrintable(errorMessage));
+
+    MatMimeAppsList list(mFileName);
+    QVERIFY(list.load());
+    QCOMPARE(list.apps(MatMimeAppsList::DefaultApplications, u"text/plain"_s), QStringList{u"editor.desktop"_s});
+    QCOMPARE(list.apps(MatMimeAppsList::AddedAssociations, u"text/plain"_s), QStringList{u"editor.desktop"_s});
+}
+
+void tst_MatMimeAppsWriter::keepsTheRest()
+{
+    QVERIFY(writeFile(mFileName,
+                      "# Written by hand\n"
+                      "[Default Applications]\n"
+                      "text/html=browser.desktop;\n"
+                      "text/plain=old.desktop;\n"
+                      "\n"
+                      "[Added Associations]\n"
+                      "text/plain=old.desktop;\n"
+                      "\n"
+                      "[Removed Associations]\n"
+                      "text/plain=editor.desktop;viewer.desktop;\n"
+                      "\n"
+                      "[Other Group]\n"
+                      "key=value\n"));
+
+    MatMimeAppsWriter writer(mFileName);
+    writer.setDefaultApp(u"text/plain"_s, u"editor.desktop"_s);
+    writer.setApps(MatMimeAppsList::AddedAssociations, u"image/png"_s, {u"viewer.desktop"_s, u"viewer.desktop"_s});
+    QVERIFY(writer.commit());
+
+    const QByteArray data = readFile(mFileName);
+    QVERIFY(data.startsWith("# Written by hand\n[Default Applications]\ntext/html=browser.desktop;\n"));
+    QVERIFY(data.contains("\n[Other Group]\nkey=value\n"));
+
+    MatMimeAppsList list(mFileName);
+    QVERIFY(list.load());
+    QCOMPARE(list.apps(MatMimeAppsList::DefaultApplications, u"text/html"_s), QStringList{u"browser.desktop"_s});
+    QCOMPARE(list.apps(MatMimeAppsList::DefaultApplications, u"text/plain"_s), QStringList{u"editor.desktop"_s});
+    QCOMPARE(list.apps(MatMimeAppsList::AddedAssociations, u"text/plain"_s),
+             QStringList({u"editor.desktop"_s, u"old.desktop"_s}));
+    QCOMPARE(list.apps(MatMimeAppsList::AddedAssociations, u"image/png"_s), QStringList{u"viewer.desktop"_s});
+    QCOMPARE(list.apps(MatMimeAppsList::RemovedAssociations, u"text/plain"_s), QStringList{u"viewer.desktop"_s});
+}
+
+void tst_MatMimeAppsWriter::removeEntry()
+{
+    QVERIFY(writeFile(mFileName, "[Default Applications]\ntext/plain=editor.desktop;\ntext/html=browser.desktop;\n"));
+
+    MatMimeAppsWriter writer(mFileName);
+    writer.setApps(MatMimeAppsList::DefaultApplications, u"text/plain"_s, QStringList());
+    QVERIFY(writer.commit());
+
+    QCOMPARE(readFile(mFileName), QByteArray("[Default Applications]\ntext/html=browser.desktop;\n"));
+}
+
+void tst_MatMimeAppsWriter::unchanged()
+{
+    // Spelled differently, but the same value, the file isn't rewritten
+    const QByteArray data("[Default Applications]\ntext/plain = editor.desktop\n"
+                          "[Added Associations]\ntext/plain=editor.desktop;;\n");
+    QVERIFY(writeFile(mFileName, data));
+
+    MatMimeAppsWriter writer(mFileName);
+    writer.setDefaultApp(u"text/plain"_s, u"editor.desktop"_s);
+    QVERIFY(writer.commit());
+
+    QCOMPARE(readFile(mFileName), data);
+}
+
+void tst_MatMimeAppsWriter::lock()
+{
+    MatMimeAppsWriter writer(mFileName);
+    QVERIFY(!isLocked());
+
+    // Held from lock() until commit() returns, whatever happens in between
+    QVERIFY(writer.lock());
+    QVERIFY(isLocked());
+    writer.setDefaultApp(u"text/plain"_s, u"editor.desktop"_s);
+    QVERIFY(isLocked());
+    QVERIFY(writer.commit());
+    QVERIFY(!isLocked());
+
+    // Nothing to write still releases it
+    QVERIFY(writer.lock());
+    QVERIFY(writer.commit());
+    QVERIFY(!isLocked());
+
+    {
+        MatMimeAppsWriter abandoned(mFileName);
+        QVERIFY(abandoned.lock());
+        QVERIFY(isLocked());
+    }
+    QVERIFY(!isLocked());
+}
+
+QTEST_GUILESS_MAIN(tst_MatMimeAppsWriter)
+
+#include "tst_matmimeappswriter.moc"
@@ -0,0 +1,245 @@
+/*
+ * libqtxdg - An Qt implementation of freedesktop.org xdg specs
+ * Copyright (C) 2026  LXQt team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301  USA
+ */
+
+
+#include "matdesktopdb.h"
+#include "matmimeappslist.h"
+#include "matresolver.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QTest>
+
+using namespace Qt::Literals::StringLiterals;
+
+class tst_MatResolver : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void defaultApp();
+    void addedAssociations();
+    void removedAssociations();
+    void declared();
+    void parentsAndAliases();
+    void tryExec();
+    void candidates();
+    void invalidateFile();
+
+private:
+    static bool writeFile(const QString &fileName, const QByteArray &data);
+    bool writeLists(const QByteArray &user, const QByteArray &system);
+    QString userFile(const QString &id) const { return mRoot.path() + "/user/applications/"_L1 + id; }
+    QString systemFile(const QString &id) const { return mRoot.path() + "/system/applications/"_L1 + id; }
+
+    QTemporaryDir mRoot;
+};
+
+// A user and a system layer, each with its own applications directory. The
+// user's viewer.desktop shadows the system one and doesn't declare
+// text/plain.
+struct ResolverData {
+    explicit ResolverData(const QString &root)
+        : layers({root + "/user/mimeapps.list"_L1, root + "/system/mimeapps.list"_L1}),
+          userDb({root + "/user/applications"_L1}),
+          systemDb({root + "/system/applications"_L1}),
+          resolver({&layers}, {&userDb, &systemDb})
+    {
+    }
+
+    MatMimeAppsLayers layers;
+    MatDesktopDb userDb;
+    MatDesktopDb systemDb;
+    MatResolver resolver;
+};
+
+bool tst_MatResolver::writeFile(const QString &fileName, const QByteArray &data)
+{
+    QFile file(fileName);
+    return QDir().mkpath(QFileInfo(fileName).absolutePath()) && file.open(QIODevice::WriteOnly)
+            && file.write(data) == data.size();
+}
+
+bool tst_MatResolver::writeLists(const QByteArray &user, const QByteArray &system)
+{
+    return writeFile(mRoot.path() + "/user/mimeapps.list"_L1, user)
+            && writeFile(mRoot.path() + "/system/mimeapps.list"_L1, system);
+}
+
+void tst_MatResolver::initTestCase()
+{
+    QVERIFY(mRoot.isValid());
+    QVERIFY(writeFile(systemFile(u"editor.desktop"_s),
+                      "[Desktop Entry]\nType=Application\nName=Editor\nExec=editor %f\nMimeType=text/plain;\n"));
+    QVERIFY(writeFile(systemFile(u"viewer.desktop"_s),
+                      "[Desktop Entry]\nType=Application\nName=Viewer\nExec=viewer %f\nMimeType=text/plain;image/png;\n"));
+    QVERIFY(writeFile(systemFile(u"hidden.desktop"_s),
+                      "[Desktop Entry]\nType=Application\nName=Hidden\nExec=hidden %f\nMimeType=text/plain;\nHidden=true\n"));
+    QVERIFY(writeFile(systemFile(u"reader.desktop"_s),
+                      "[Desktop Entry]\nType=Application\nName=Reader\nExec=reader %f\nMimeType=application/pdf;\n"));
+    QVERIFY(writeFile(systemFile(u"uninstalled.desktop"_s),
+                      "[Desktop Entry]\nType=Application\nName=Uninstalled\nExec=uninstalled %f\n"
+                      "TryExec=/nonexistent/uninstalled\nMimeType=image/png;application/pdf;\n"));
+    QVERIFY(writeFile(userFile(u"viewer.desktop"_s),
+                      "[Desktop Entry]\nType=Application\nName=Viewer\nExec=viewer %f\nMimeType=image/png;\n"));
+}
+
+void tst_MatResolver::defaultApp()
+{
+    // Uninstalled and hidden applications are skipped, the first layer wins
+    QVERIFY(writeLists("[Default Applications]\ntext/plain=missing.desktop;hidden.desktop;viewer.desktop;\n",
+                       "[Default Applications]\ntext/plain=editor.desktop;\n"));
+    ResolverData data(mRoot.path());
+
+    const MatDesktopEntry *app = data.resolver.defaultApp(u"text/plain"_s);
+    QVERIFY(app != nullptr);
+    QCOMPARE(app->id, u"viewer.desktop"_s);
+    QCOMPARE(app->fileName, userFile(u"viewer.desktop"_s));
+
+    QCOMPARE(data.resolver.entry(u"hidden.desktop"_s), nullptr);
+    QCOMPARE(data.resolver.entry(u"missing.desktop"_s), nullptr);
+    QCOMPARE(data.resolver.entry(u"editor.desktop"_s)->fileName, systemFile(u"editor.desktop"_s));
+}
+
+void tst_MatResolver::addedAssociations()
+{
+    QVERIFY(writeLists("[Added Associations]\nimage/png=missing.desktop;editor.desktop;\n",
+                       "[Default Applications]\nimage/png=missing.desktop;\n"));
+    ResolverData data(mRoot.path());
+
+    const MatDesktopEntry *app = data.resolver.defaultApp(u"image/png"_s);
+    QVERIFY(app != nullptr);
+    QCOMPARE(app->id, u"editor.desktop"_s);
+}
+
+void tst_MatResolver::removedAssociations()
+{
+    // Removed associations hide the ones of less important layers and the
+    // declared ones, but not the defaults
+    QVERIFY(writeLists("[Removed Associations]\nimage/png=editor.desktop;viewer.desktop;\ntext/plain=editor.desktop;\n",
+                       "[Added Associations]\nimage/png=editor.desktop;\n"
+                       "[Default Applications]\ntext/html=editor.desktop;\n"
+                       "[Removed Associations]\ntext/html=editor.desktop;\n"));
+    ResolverData data(mRoot.path());
+
+    QCOMPARE(data.resolver.defaultApp(u"image/png"_s), nullptr);
+    QCOMPARE(data.resolver.defaultApp(u"text/plain"_s), nullptr);
+    QVERIFY(data.resolver.defaultApp(u"text/html"_s) != nullptr);
+    QCOMPARE(data.resolver.removedApps(u"image/png"_s), QSet<QString>({u"editor.desktop"_s, u"viewer.desktop"_s}));
+}
+
+void tst_MatResolver::declared()
+{
+    // The system viewer.desktop declares text/plain, but is shadowed
+    QVERIFY(writeLists(QByteArray(), QByteArray()));
+    ResolverData data(mRoot.path());
+
+    const MatDesktopEntry *app = data.resolver.defaultApp(u"text/plain"_s);
+    QVERIFY(app != nullptr);
+    QCOMPARE(app->id, u"editor.desktop"_s);
+
+    app = data.resolver.defaultApp(u"image/png"_s);
+    QVERIFY(app != nullptr);
+    QCOMPARE(app->fileName, userFile(u"viewer.desktop"_s));
+
+    QCOMPARE(data.resolver.defaultApp(u"application/x-unknown"_s), nullptr);
+}
+
+void tst_MatResolver::parentsAndAliases()
+{
+    QVERIFY(writeLists(QByteArray(), "[Default Applications]\napplication/pdf=reader.desktop;\n"));
+    ResolverData data(mRoot.path());
+
+    // Nothing handles text/x-csrc itself, its parent text/plain is asked
+    const MatDesktopEntry *app = data.resolver.defaultApp(u"text/x-csrc"_s);
+    QVERIFY(app != nullptr);
+    QCOMPARE(app->id, u"editor.desktop"_s);
+
+    // An alias has the associations of its canonical name
+    app = data.resolver.defaultApp(u"application/x-pdf"_s);
+    QVERIFY(app != nullptr);
+    QCOMPARE(app->id, u"reader.desktop"_s);
+
+    // A removed association also hides the application from the parents
+    QVERIFY(writeLists("[Removed Associations]\ntext/x-csrc=editor.desktop;\n", QByteArray()));
+    ResolverData removed(mRoot.path());
+    QCOMPARE(removed.resolver.defaultApp(u"text/x-csrc"_s), nullptr);
+    QVERIFY(removed.resolver.defaultApp(u"text/plain"_s) != nullptr);
+}
+
+void tst_MatResolver::tryExec()
+{
+    // Like an uninstalled application, whatever the lists say
+    QVERIFY(writeLists("[Default Applications]\napplication/pdf=uninstalled.desktop;\n", QByteArray()));
+    ResolverData data(mRoot.path());
+
+    QCOMPARE(data.resolver.entry(u"uninstalled.desktop"_s), nullptr);
+    const MatDesktopEntry *app = data.resolver.defaultApp(u"application/pdf"_s);
+    QVERIFY(app != nullptr);
+    QCOMPARE(app->id, u"reader.desktop"_s);
+}
+
+void tst_MatResolver::candidates()
+{
+    QVERIFY(writeLists("[Default Applications]\ntext/plain=viewer.desktop;\n",
+                       "[Added Associations]\ntext/plain=viewer.desktop;missing.desktop;\n"));
+    ResolverData data(mRoot.path());
+
+    const QList<MatResolver::Candidate> candidates = data.resolver.candidates(u"text/plain"_s);
+    QCOMPARE(candidates.size(), 2);
+    QCOMPARE(candidates.at(0).entry->id, u"viewer.desktop"_s);
+    QCOMPARE(candidates.at(0).source, MatResolver::DefaultSource);
+    QCOMPARE(candidates.at(1).entry->id, u"editor.desktop"_s);
+    QCOMPARE(candidates.at(1).source, MatResolver::DeclaredSource);
+    QCOMPARE(candidates.constFirst().entry, data.resolver.defaultApp(u"text/plain"_s));
+}
+
+void tst_MatResolver::invalidateFile()
+{
+    // Both files have the id kde-foo.desktop, the directory isn't clean
+    const QString dir = mRoot.path() + "/invalidate/applications"_L1;
+    const QByteArray contents = "[Desktop Entry]\nType=Application\nName=Foo\nExec=foo %f\n";
+    QVERIFY(writeFile(dir + "/kde-foo.desktop"_L1, contents));
+    QVERIFY(writeFile(dir + "/kde/foo.desktop"_L1, contents));
+    MatDesktopDb db({mRoot.path() + "/invalidate/./applications/"_L1});
+
+    const MatDesktopEntry *entry = db.entry(u"kde-foo.desktop"_s);
+    QVERIFY(entry != nullptr);
+    const QString removed = entry->fileName;
+    const QString remaining = removed.endsWith("/kde-foo.desktop"_L1) ? dir + "/kde/foo.desktop"_L1
+                                                                      : dir + "/kde-foo.desktop"_L1;
+    QVERIFY(QFile::remove(removed));
+    db.invalidateFile(removed);
+
+    entry = db.entry(u"kde-foo.desktop"_s);
+    QVERIFY(entry != nullptr);
+    QCOMPARE(entry->fileName, remaining);
+
+    QVERIFY(QFile::remove(remaining));
+    db.invalidateFile(remaining);
+    QCOMPARE(db.entry(u"kde-foo.desktop"_s), nullptr);
+    QVERIFY(!db.hasFile(u"kde-foo.desktop"_s));
+}
+
+QTEST_GUILESS_MAIN(tst_MatResolver)
+
+#include "tst_matresolver.moc"